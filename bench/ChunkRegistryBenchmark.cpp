@@ -0,0 +1,118 @@
+//
+// Lookup throughput of the chunk registry against the map it replaced.
+//
+
+#include "ChunkRegistryBenchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "Chunk/ChunkRegistry.hpp"
+
+namespace {
+    // The hash activeChunks used before the registry
+    struct XorCoordHash {
+        std::size_t operator()(const ChunkCoord& c) const noexcept {
+            return std::hash<int>()(c.x) ^ (std::hash<int>()(c.z) << 1);
+        }
+    };
+
+    // Stand-in value; the benchmark measures the lookup, not the chunk
+    struct Entry {
+        int value = 0;
+    };
+
+    // Coordinates a thread looks up: mostly loaded, the rest just past the edge
+    std::vector<ChunkCoord> lookupPattern(int side, int count, unsigned seed) {
+        std::vector<ChunkCoord> coords(count);
+        for (ChunkCoord& c : coords) {
+            seed = seed * 1664525u + 1013904223u;
+            int x = (int)(seed >> 8) % side - side / 2;
+            seed = seed * 1664525u + 1013904223u;
+            int z = (int)(seed >> 8) % side - side / 2;
+            if ((seed & 7) == 0) x = side - side / 2; // Miss
+            c = {x, z};
+        }
+        return coords;
+    }
+
+    template <typename Lookup>
+    double measure(int threads, int lookupsPerThread, int side, Lookup lookup) {
+        std::vector<std::vector<ChunkCoord>> patterns;
+        for (int t = 0; t < threads; t++) {
+            patterns.push_back(lookupPattern(side, lookupsPerThread, t + 1));
+        }
+
+        std::atomic<bool> start{false};
+        std::atomic<long> found{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                while (!start.load()) std::this_thread::yield();
+                long hits = 0;
+                for (const ChunkCoord& c : patterns[t]) hits += lookup(c) != nullptr;
+                found += hits;
+            });
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        start = true;
+        for (auto& w : workers) w.join();
+        double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        return seconds > 0.0 ? (double)threads * lookupsPerThread / seconds : 0.0;
+    }
+} // namespace
+
+std::vector<ChunkRegistryBenchmark::Result> ChunkRegistryBenchmark::run(int lookupsPerThread) {
+    std::vector<Result> results;
+
+    for (int chunks : {1000, 10000}) {
+        const int side = (int)std::ceil(std::sqrt((double)chunks));
+
+        std::unordered_map<ChunkCoord, std::unique_ptr<Entry>, XorCoordHash> map;
+        std::mutex mapMutex;
+        CoordRegistry<Entry> registry;
+        for (int x = -side / 2; x < side - side / 2; x++) {
+            for (int z = -side / 2; z < side - side / 2; z++) {
+                map[{x, z}] = std::make_unique<Entry>();
+                registry.insert({x, z}, std::make_unique<Entry>());
+            }
+        }
+
+        size_t worstProbe = 0;
+        for (size_t b = 0; b < map.bucket_count(); b++) {
+            worstProbe = std::max(worstProbe, map.bucket_size(b));
+        }
+
+        for (int threads : {1, 4}) {
+            Result result;
+            result.chunks = side * side;
+            result.threads = threads;
+            result.worstProbe = worstProbe;
+
+            result.unlockedMap = measure(threads, lookupsPerThread, side, [&](const ChunkCoord& c) {
+                auto it = map.find(c);
+                return it == map.end() ? nullptr : it->second.get();
+            });
+            result.mutexMap = measure(threads, lookupsPerThread, side, [&](const ChunkCoord& c) {
+                std::lock_guard<std::mutex> lock(mapMutex);
+                auto it = map.find(c);
+                return it == map.end() ? nullptr : it->second.get();
+            });
+            result.registry = measure(threads, lookupsPerThread, side,
+                                      [&](const ChunkCoord& c) { return registry.find(c); });
+
+            results.push_back(result);
+        }
+    }
+
+    return results;
+}
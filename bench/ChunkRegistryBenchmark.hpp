@@ -0,0 +1,30 @@
+//
+// Lookup throughput of the chunk registry against the map it replaced.
+//
+
+#ifndef REFACTOREDCLONE_CHUNKREGISTRYBENCHMARK_HPP
+#define REFACTOREDCLONE_CHUNKREGISTRYBENCHMARK_HPP
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ChunkRegistryBenchmark {
+    // Lookups per second over a square of loaded chunks, one in eight a miss just outside it.
+    // The maps are std::unordered_map with the old xor hash, read without a lock as the main
+    // thread did and behind one lock as the workers did; threads runs the same lookups from
+    // that many threads at once.
+    struct Result {
+        int chunks = 0;
+        int threads = 0;
+        double unlockedMap = 0.0;
+        double mutexMap = 0.0;
+        double registry = 0.0;
+        size_t worstProbe = 0; // Longest bucket in the old-hash map
+    };
+
+    // 1k and 10k chunks, each from 1 and 4 threads
+    std::vector<Result> run(int lookupsPerThread);
+} // namespace ChunkRegistryBenchmark
+
+#endif
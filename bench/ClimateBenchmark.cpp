@@ -0,0 +1,54 @@
+//
+// Accuracy and cost of coarse-lattice climate sampling against evaluating every column.
+//
+
+#include "ClimateBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Chunk/Chunk.hpp"
+
+ClimateBenchmark::Result ClimateBenchmark::run(const ChunkCoord& center, int chunkRadius) {
+    using Clock = std::chrono::steady_clock;
+    Result report;
+
+    ChunkClimate exact;
+    ChunkClimate coarse;
+    double totalError = 0.0;
+
+    for (int cx = center.x - chunkRadius; cx <= center.x + chunkRadius; cx++) {
+        for (int cz = center.z - chunkRadius; cz <= center.z + chunkRadius; cz++) {
+            ChunkCoord coord{cx, cz};
+
+            auto t0 = Clock::now();
+            ChunkHelper::sampleChunkClimateExact(coord, exact);
+            auto t1 = Clock::now();
+            ChunkHelper::sampleChunkClimateCoarse(coord, coarse);
+            auto t2 = Clock::now();
+
+            report.exactMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            report.coarseMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+            for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                    const ColumnClimate& a = exact.at(x, z);
+                    const ColumnClimate& b = coarse.at(x, z);
+
+                    float error = std::abs(a.height - b.height);
+                    totalError += error;
+                    report.maxHeightError = std::max(report.maxHeightError, error);
+                    if ((int)a.height != (int)b.height) report.surfaceMismatches++;
+                    if (a.biome != b.biome) report.biomeMismatches++;
+                    report.columns++;
+                }
+            }
+        }
+    }
+
+    if (report.columns > 0) {
+        report.meanHeightError = (float)(totalError / report.columns);
+    }
+    return report;
+}
@@ -0,0 +1,26 @@
+//
+// Accuracy and cost of coarse-lattice climate sampling against evaluating every column.
+//
+
+#ifndef REFACTOREDCLONE_CLIMATEBENCHMARK_HPP
+#define REFACTOREDCLONE_CLIMATEBENCHMARK_HPP
+
+#pragma once
+#include "Chunk/ChunkCoord.hpp"
+
+namespace ClimateBenchmark {
+    struct Result {
+        int columns = 0;
+        float maxHeightError = 0.0f;
+        float meanHeightError = 0.0f;
+        int surfaceMismatches = 0; // Columns whose integer surface block differs
+        int biomeMismatches = 0;
+        double exactMs = 0.0;
+        double coarseMs = 0.0;
+    };
+
+    // Generate climate both ways for a square of chunks and measure the difference and cost
+    Result run(const ChunkCoord& center, int chunkRadius);
+} // namespace ClimateBenchmark
+
+#endif
@@ -0,0 +1,212 @@
+//
+// Sky-light flood cost: the packed LightQueue against the std::queue it replaced, and seeding
+// beside covered columns against seeding every lit voxel. Also an edit check that removing one
+// of two adjacent emitters leaves the other lit.
+//
+
+#include "LightingBenchmark.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include "Lighitng/LightingSystem.hpp"
+
+namespace {
+    // The node every lighting pass queued before LightNode was packed
+    struct WideLightNode {
+        int x, y, z;
+        int chunkX, chunkZ;
+        uint8_t lightLevel;
+    };
+
+    // propagateSkyLight as it was before the packed queue and heightmap seeding, minus the debug
+    // output; returns the nodes it popped
+    size_t propagateWithDeque(Chunk& chunk) {
+        std::queue<WideLightNode> lightQueue;
+
+        const int topSection = chunk.getTopSection();
+        for (int s = 0; s <= topSection; s++) {
+            if (chunk.sections[s].isAllOpaque()) continue;
+
+            for (int y = s * SECTION_SIZE; y < (s + 1) * SECTION_SIZE; y++) {
+                for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                        uint8_t sky = chunk.getSkyLight(x, y, z);
+                        if (sky > 0) {
+                            lightQueue.push(
+                                {x, y, z, chunk.chunkCoords.x, chunk.chunkCoords.z, sky});
+                        }
+                    }
+                }
+            }
+        }
+
+        size_t visited = 0;
+        while (!lightQueue.empty()) {
+            WideLightNode node = lightQueue.front();
+            lightQueue.pop();
+            visited++;
+
+            if (node.lightLevel <= 1) continue;
+
+            for (int f = 0; f < 6; f++) {
+                int nx = node.x + dx1[f];
+                int ny = node.y + dy1[f];
+                int nz = node.z + dz1[f];
+
+                if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SIZE_Y || nz < 0 ||
+                    nz >= CHUNK_SIZE_Z)
+                    continue;
+
+                if (isBlockOpaque(chunk.getBlock(nx, ny, nz))) continue;
+
+                uint8_t newLight = node.lightLevel - 1;
+                if (newLight > chunk.getSkyLight(nx, ny, nz)) {
+                    chunk.setSkyLight(nx, ny, nz, newLight);
+                    lightQueue.push({nx, ny, nz, node.chunkX, node.chunkZ, newLight});
+                }
+            }
+        }
+
+        return visited;
+    }
+
+    // The same all-voxel seeding through LightQueue, which is how propagateSkyLight seeded before
+    // the heightmap; returns the nodes it popped
+    size_t propagateWithLightQueue(Chunk& chunk) {
+        static LightQueue lightQueue;
+        lightQueue.clear();
+
+        const int topSection = chunk.getTopSection();
+        for (int s = 0; s <= topSection; s++) {
+            if (chunk.sections[s].isAllOpaque()) continue;
+
+            for (int y = s * SECTION_SIZE; y < (s + 1) * SECTION_SIZE; y++) {
+                for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                        uint8_t sky = chunk.getSkyLight(x, y, z);
+                        if (sky > 0) {
+                            lightQueue.push(LightNode(x, y, z, LightNeighborhood::CENTER, sky));
+                        }
+                    }
+                }
+            }
+        }
+
+        return LightingSystem::spreadSkyLight(chunk, lightQueue);
+    }
+
+    // Light in the origin chunk and its neighbours, which is as far as an edit in the middle of
+    // the origin chunk reaches
+    std::vector<uint8_t> captureLight() {
+        std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+
+        std::vector<uint8_t> light;
+        for (int x = -1; x <= 1; x++) {
+            for (int z = -1; z <= 1; z++) {
+                const Chunk* chunk = ChunkHelper::activeChunks.find({x, z});
+                if (!chunk) continue;
+
+                const uint8_t* packed = chunk->packedLight[0][0];
+                light.insert(light.end(), packed, packed + sizeof(chunk->packedLight));
+            }
+        }
+        return light;
+    }
+} // namespace
+
+LightingBenchmark::Result LightingBenchmark::run(int side, int passes) {
+    using Clock = std::chrono::steady_clock;
+
+    Result result;
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    for (int x = 0; x < side; x++) {
+        for (int z = 0; z < side; z++) {
+            chunks.push_back(ChunkHelper::generateChunkAsync(
+                {(float)(x - side / 2), 0.0f, (float)(z - side / 2)}));
+        }
+    }
+    result.chunks = (int)chunks.size();
+
+    // Light as the column pass leaves it, which every flood starts from
+    constexpr size_t LIGHT_BYTES = sizeof(Chunk::packedLight);
+    std::vector<uint8_t> columns(chunks.size() * LIGHT_BYTES);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        LightingSystem::fillSkyColumns(*chunks[i]);
+        memcpy(&columns[i * LIGHT_BYTES], chunks[i]->packedLight, LIGHT_BYTES);
+    }
+
+    auto timePasses = [&](auto&& flood) {
+        double seconds = 0.0;
+        for (int pass = 0; pass < passes; pass++) {
+            for (size_t i = 0; i < chunks.size(); i++) {
+                memcpy(chunks[i]->packedLight, &columns[i * LIGHT_BYTES], LIGHT_BYTES);
+
+                auto start = Clock::now();
+                flood(*chunks[i]);
+                seconds += std::chrono::duration<double>(Clock::now() - start).count();
+            }
+        }
+        return seconds;
+    };
+
+    // Time one flood over every chunk, keep what it left and count the nodes it popped
+    auto measure = [&](auto&& flood, std::vector<uint8_t>& light, size_t& nodes) {
+        double seconds = timePasses(flood);
+        for (size_t i = 0; i < chunks.size(); i++) {
+            memcpy(chunks[i]->packedLight, &columns[i * LIGHT_BYTES], LIGHT_BYTES);
+            nodes += flood(*chunks[i]);
+            memcpy(&light[i * LIGHT_BYTES], chunks[i]->packedLight, LIGHT_BYTES);
+        }
+        return seconds;
+    };
+
+    std::vector<uint8_t> dequeLight(chunks.size() * LIGHT_BYTES);
+    std::vector<uint8_t> packedLight(chunks.size() * LIGHT_BYTES);
+    std::vector<uint8_t> seededLight(chunks.size() * LIGHT_BYTES);
+    size_t packedNodes = 0;
+
+    double dequeSeconds = measure(propagateWithDeque, dequeLight, result.voxels);
+    double packedSeconds = measure(propagateWithLightQueue, packedLight, packedNodes);
+    double seededSeconds = measure(LightingSystem::propagateSkyLight, seededLight,
+                                   result.seededNodes);
+
+    result.matches = dequeLight == packedLight && dequeLight == seededLight;
+
+    const double runs = (double)chunks.size() * passes;
+    result.dequeVoxelsPerSec = result.voxels * passes / dequeSeconds;
+    result.packedVoxelsPerSec = result.voxels * passes / packedSeconds;
+    result.dequeMicrosPerChunk = dequeSeconds * 1e6 / runs;
+    result.packedMicrosPerChunk = packedSeconds * 1e6 / runs;
+    result.seededMicrosPerChunk = seededSeconds * 1e6 / runs;
+    return result;
+}
+
+LightingBenchmark::EmitterRemoval LightingBenchmark::removeAdjacentEmitter() {
+    using Clock = std::chrono::steady_clock;
+
+    // Open air near the top of the world, where nothing else gives off light
+    constexpr int X = 8;
+    constexpr int Y = CHUNK_SIZE_Y - 8;
+    constexpr int Z = 8;
+
+    EmitterRemoval result;
+
+    ChunkHelper::setBlock(X, Y, Z, ID_TORCH);
+    const std::vector<uint8_t> torchAlone = captureLight();
+
+    // Glowstone is brighter, so the torch's voxel is dimmer than the one being cleared
+    ChunkHelper::setBlock(X + 1, Y, Z, ID_GLOWSTONE);
+    auto start = Clock::now();
+    ChunkHelper::setBlock(X + 1, Y, Z, ID_AIR);
+    result.removeMicros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    result.matches = captureLight() == torchAlone;
+
+    ChunkHelper::setBlock(X, Y, Z, ID_AIR);
+    return result;
+}
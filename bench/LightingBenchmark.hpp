@@ -0,0 +1,46 @@
+//
+// Sky-light flood cost: the packed LightQueue against the std::queue it replaced, and seeding
+// beside covered columns against seeding every lit voxel. Also an edit check that removing one
+// of two adjacent emitters leaves the other lit.
+
+#ifndef REFACTOREDCLONE_LIGHTINGBENCHMARK_HPP
+#define REFACTOREDCLONE_LIGHTINGBENCHMARK_HPP
+
+#pragma once
+#include <cstddef>
+
+namespace LightingBenchmark {
+    // Every flood runs over the same freshly generated chunks, starting from the column pass
+    // each time
+    struct Result {
+        int chunks = 0;
+
+        // Both queues seeded with every lit voxel, as before either change, so only the queue
+        // differs
+        size_t voxels = 0; // Nodes taken off the queue per pass over every chunk
+        double dequeVoxelsPerSec = 0.0;
+        double packedVoxelsPerSec = 0.0;
+        double dequeMicrosPerChunk = 0.0;
+        double packedMicrosPerChunk = 0.0;
+
+        // propagateSkyLight as it is: LightQueue, seeded only beside covered columns
+        size_t seededNodes = 0;
+        double seededMicrosPerChunk = 0.0;
+
+        bool matches = false; // All three left the same light in every chunk
+    };
+
+    // Generates a side x side square of chunks around the origin
+    Result run(int side, int passes);
+
+    // Glowstone placed beside a torch and removed again, in the chunks around the origin that are
+    // already in activeChunks. Its removal clears the torch's light along with its own.
+    struct EmitterRemoval {
+        double removeMicros = 0.0; // The removing setBlock, relight included
+        bool matches = false;      // Light afterwards is what the torch alone gave
+    };
+
+    EmitterRemoval removeAdjacentEmitter();
+} // namespace LightingBenchmark
+
+#endif
@@ -0,0 +1,81 @@
+//
+// Opaque meshing cost of greedy against per-face quads, and bitmask against per-voxel culling.
+//
+
+#include "MeshingBenchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "Rendering/Renderer.hpp"
+
+MeshingBenchmark::MeshingReport MeshingBenchmark::compareMeshingModes() {
+    using Clock = std::chrono::steady_clock;
+    MeshingReport report;
+
+    std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+    for (Chunk* chunk : ChunkHelper::activeChunks) {
+        if (!chunk->loaded) continue;
+
+        const NeighborhoodSnapshot& snapshot = Renderer::snapshotNeighborhood(*chunk);
+
+        auto t0 = Clock::now();
+        ChunkMeshTriple perFace = Renderer::buildChunkMeshesInternal(*chunk, snapshot, false);
+        auto t1 = Clock::now();
+        ChunkMeshTriple greedy = Renderer::buildChunkMeshesInternal(*chunk, snapshot, true);
+        auto t2 = Clock::now();
+
+        report.perFaceMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        report.greedyMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+        // Only the opaque pass differs between the two modes
+        report.perFaceVertices += perFace.opaque.vertices.size();
+        report.greedyVertices += greedy.opaque.vertices.size();
+        report.perFaceBytes += perFace.opaque.byteSize();
+        report.greedyBytes += greedy.opaque.byteSize();
+        report.chunks++;
+    }
+
+    return report;
+}
+
+MeshingBenchmark::FaceCullingReport MeshingBenchmark::compareFaceCulling() {
+    using Clock = std::chrono::steady_clock;
+    FaceCullingReport report;
+
+    // Quads as sortable 32-byte records; the two paths emit the same faces in different orders
+    auto sortedQuads = [](const ChunkMeshBuffers& buf) {
+        std::vector<std::array<uint16_t, 16>> quads(buf.vertices.size() / 4);
+        memcpy(quads.data(), buf.vertices.data(), buf.vertices.size() * sizeof(PackedVertex));
+        std::sort(quads.begin(), quads.end());
+        return quads;
+    };
+
+    std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+    for (Chunk* chunk : ChunkHelper::activeChunks) {
+        if (!chunk->loaded) continue;
+
+        const NeighborhoodSnapshot& snapshot = Renderer::snapshotNeighborhood(*chunk);
+        static thread_local OpaqueFaceMasks faceMasks;
+        ChunkMeshBuffers perVoxel, bitmask;
+
+        auto t0 = Clock::now();
+        Renderer::meshOpaqueFacesPerVoxel(perVoxel, *chunk, snapshot);
+        auto t1 = Clock::now();
+        Renderer::buildOpaqueFaceMasks(*chunk, snapshot, faceMasks);
+        Renderer::meshOpaqueFaces(bitmask, *chunk, snapshot, faceMasks);
+        auto t2 = Clock::now();
+
+        report.perVoxelMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        report.bitmaskMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        report.faces += bitmask.vertices.size() / 4;
+        report.matches = report.matches && sortedQuads(perVoxel) == sortedQuads(bitmask);
+        report.chunks++;
+    }
+
+    return report;
+}
@@ -0,0 +1,44 @@
+//
+// Opaque meshing cost of greedy against per-face quads, and bitmask against per-voxel culling.
+//
+
+#ifndef REFACTOREDCLONE_MESHINGBENCHMARK_HPP
+#define REFACTOREDCLONE_MESHINGBENCHMARK_HPP
+
+#pragma once
+#include <cstddef>
+
+namespace MeshingBenchmark {
+    struct MeshingReport {
+        int chunks = 0;
+        size_t perFaceVertices = 0;
+        size_t greedyVertices = 0;
+        size_t perFaceBytes = 0;
+        size_t greedyBytes = 0;
+        double perFaceMs = 0.0;
+        double greedyMs = 0.0;
+    };
+
+    // Mesh every loaded chunk's opaque geometry both ways and total the results
+    MeshingReport compareMeshingModes();
+
+    struct FaceCullingReport {
+        int chunks = 0;
+        size_t faces = 0;
+        double perVoxelMs = 0.0;
+        double bitmaskMs = 0.0;
+        bool matches = true;
+
+        double perVoxelFacesPerSec() const {
+            return perVoxelMs > 0.0 ? faces * 1000.0 / perVoxelMs : 0.0;
+        }
+        double bitmaskFacesPerSec() const {
+            return bitmaskMs > 0.0 ? faces * 1000.0 / bitmaskMs : 0.0;
+        }
+    };
+
+    // Per-face opaque meshing of every loaded chunk with per-voxel and bitmask culling
+    FaceCullingReport compareFaceCulling();
+} // namespace MeshingBenchmark
+
+#endif
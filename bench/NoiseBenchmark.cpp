@@ -0,0 +1,51 @@
+//
+// Batch grid sampling throughput of FastNoiseLite against its scalar path.
+//
+
+#include "NoiseBenchmark.hpp"
+
+#include <chrono>
+
+#include "Chunk/Chunk.hpp"
+
+std::vector<NoiseBenchmark::Result> NoiseBenchmark::run(int gridSize, int repeats) {
+    using Clock = std::chrono::steady_clock;
+
+    struct Case {
+        const char* name;
+        const FastNoiseLite* noise;
+    };
+    const Case cases[] = {
+        {"OpenSimplex2S", &ChunkHelper::terrainNoise},
+        {"Perlin", &ChunkHelper::caveNoise},
+        {"Cellular", &ChunkHelper::temperatureNoise},
+    };
+
+    std::vector<float> scalar(gridSize * gridSize);
+    std::vector<float> batch(gridSize * gridSize);
+    const double samples = (double)gridSize * gridSize * repeats;
+
+    std::vector<Result> results;
+    for (const Case& c : cases) {
+        Result result{c.name};
+
+        auto t0 = Clock::now();
+        for (int r = 0; r < repeats; r++) {
+            c.noise->GetNoiseGrid2DScalar(scalar.data(), (float)(r * gridSize), 0.0f, gridSize,
+                                          gridSize);
+        }
+        auto t1 = Clock::now();
+        for (int r = 0; r < repeats; r++) {
+            c.noise->GetNoiseGrid2D(batch.data(), (float)(r * gridSize), 0.0f, gridSize,
+                                    gridSize);
+        }
+        auto t2 = Clock::now();
+
+        result.scalarSamplesPerSec = samples / std::chrono::duration<double>(t1 - t0).count();
+        result.batchSamplesPerSec = samples / std::chrono::duration<double>(t2 - t1).count();
+        // Both buffers hold the last repeat
+        result.matches = scalar == batch;
+        results.push_back(result);
+    }
+    return results;
+}
@@ -0,0 +1,24 @@
+//
+// Batch grid sampling throughput of FastNoiseLite against its scalar path.
+//
+
+#ifndef REFACTOREDCLONE_NOISEBENCHMARK_HPP
+#define REFACTOREDCLONE_NOISEBENCHMARK_HPP
+
+#pragma once
+#include <vector>
+
+namespace NoiseBenchmark {
+    struct Result {
+        const char* name;
+        double scalarSamplesPerSec = 0.0;
+        double batchSamplesPerSec = 0.0;
+        bool matches = true; // Batch output is identical to the scalar path
+    };
+
+    // Time GetNoiseGrid2D against the scalar path for the noise types used by world generation
+    // (OpenSimplex2S, Perlin, Cellular) on a gridSize x gridSize grid, `repeats` times each
+    std::vector<Result> run(int gridSize, int repeats);
+} // namespace NoiseBenchmark
+
+#endif
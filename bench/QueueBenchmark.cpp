@@ -0,0 +1,92 @@
+//
+// Throughput comparison of the mutex queue against the lock-free ones.
+//
+
+#include "QueueBenchmark.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "Chunk/Chunk.hpp"
+#include "MultiThreading/LockFreeQueue.hpp"
+
+namespace {
+    constexpr size_t RING_CAPACITY = 1024;
+
+    // Adapters so one driver runs every queue; the bounded rings spin while full
+    template <typename T>
+    void push(ThreadSafeQueue<T>& queue, T item) {
+        queue.push(std::move(item));
+    }
+
+    template <typename T, bool SingleConsumer>
+    void push(BoundedQueue<T, SingleConsumer>& queue, T item) {
+        while (!queue.try_push(item)) std::this_thread::yield();
+    }
+
+    // Time producers * itemsPerProducer pushes drained by consumers threads, in items per second
+    template <typename Queue>
+    double measure(Queue& queue, int producers, int consumers, int itemsPerProducer) {
+        const long total = (long)producers * itemsPerProducer;
+        std::atomic<long> consumed{0};
+        std::atomic<bool> start{false};
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < producers; p++) {
+            threads.emplace_back([&, p]() {
+                while (!start.load()) std::this_thread::yield();
+                for (int i = 0; i < itemsPerProducer; i++) push(queue, p * itemsPerProducer + i);
+            });
+        }
+        for (int c = 0; c < consumers; c++) {
+            threads.emplace_back([&]() {
+                while (!start.load()) std::this_thread::yield();
+                int item;
+                while (consumed.load(std::memory_order_relaxed) < total) {
+                    if (queue.try_pop(item)) {
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        start = true;
+        for (auto& t : threads) t.join();
+        double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        return seconds > 0.0 ? total / seconds : 0.0;
+    }
+} // namespace
+
+std::vector<QueueBenchmark::Result> QueueBenchmark::run(int itemsPerProducer) {
+    std::vector<Result> results;
+
+    for (int producers : {2, 4, 8, 16}) {
+        Result result;
+        result.producers = producers;
+        {
+            ThreadSafeQueue<int> queue;
+            result.mutexMpsc = measure(queue, producers, 1, itemsPerProducer);
+        }
+        {
+            MpscQueue<int> queue(RING_CAPACITY);
+            result.lockFreeMpsc = measure(queue, producers, 1, itemsPerProducer);
+        }
+        {
+            ThreadSafeQueue<int> queue;
+            result.mutexMpmc = measure(queue, producers, producers, itemsPerProducer);
+        }
+        {
+            MpmcQueue<int> queue(RING_CAPACITY);
+            result.lockFreeMpmc = measure(queue, producers, producers, itemsPerProducer);
+        }
+        results.push_back(result);
+    }
+
+    return results;
+}
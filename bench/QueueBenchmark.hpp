@@ -0,0 +1,26 @@
+//
+// Throughput comparison of the mutex queue against the lock-free ones.
+//
+
+#ifndef REFACTOREDCLONE_QUEUEBENCHMARK_HPP
+#define REFACTOREDCLONE_QUEUEBENCHMARK_HPP
+
+#pragma once
+#include <vector>
+
+namespace QueueBenchmark {
+    // Items moved per second through each queue with the given number of producer threads. The
+    // MPSC runs drain with one consumer; the MPMC runs with as many consumers as producers.
+    struct Result {
+        int producers = 0;
+        double mutexMpsc = 0.0;
+        double lockFreeMpsc = 0.0;
+        double mutexMpmc = 0.0;
+        double lockFreeMpmc = 0.0;
+    };
+
+    // One Result per producer count in 2, 4, 8, 16
+    std::vector<Result> run(int itemsPerProducer);
+} // namespace QueueBenchmark
+
+#endif
@@ -0,0 +1,163 @@
+//
+// Micro-benchmarks for the engine's hot paths, kept out of the game binary. Runs every benchmark,
+// or just the ones named on the command line.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include "ChunkRegistryBenchmark.hpp"
+#include "ClimateBenchmark.hpp"
+#include "LightingBenchmark.hpp"
+#include "MeshingBenchmark.hpp"
+#include "NoiseBenchmark.hpp"
+#include "QueueBenchmark.hpp"
+
+#include "Lighitng/LightingSystem.hpp"
+#include "Rendering/Renderer.hpp"
+#include "Settings.hpp"
+
+namespace {
+    // Generate, light and publish a square of chunks around the origin the way streaming does,
+    // for the benchmarks that read activeChunks. Meshing needs no GPU, so nothing is uploaded.
+    void loadWorld(int radius) {
+        for (int x = -radius; x <= radius; x++) {
+            for (int z = -radius; z <= radius; z++) {
+                std::unique_ptr<Chunk> chunk =
+                    ChunkHelper::generateChunkAsync({(float)x, 0.0f, (float)z});
+                LightingSystem::calculateSkyLight(*chunk);
+                LightingSystem::calculateBlockLight(*chunk);
+                chunk->loaded = true;
+
+                const ChunkCoord coord = chunk->chunkCoords;
+                std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+                ChunkHelper::activeChunks.insert(coord, std::move(chunk));
+                LightingSystem::connectChunk(coord);
+            }
+        }
+    }
+
+    void benchmarkNoise() {
+        for (const NoiseBenchmark::Result& r : NoiseBenchmark::run(256, 8)) {
+            printf("%s noise: scalar %.1fM samples/s, batch %.1fM samples/s (%.2fx)%s\n", r.name,
+                   r.scalarSamplesPerSec / 1e6, r.batchSamplesPerSec / 1e6,
+                   r.batchSamplesPerSec / r.scalarSamplesPerSec, r.matches ? "" : " MISMATCH");
+        }
+    }
+
+    void benchmarkClimate() {
+        ClimateBenchmark::Result r = ClimateBenchmark::run({0, 0}, 4);
+        printf("Coarse climate vs exact over %d columns: height error mean %.3f max %.3f, "
+               "surface differs %d, biome differs %d, time %.2fms vs %.2fms\n",
+               r.columns, r.meanHeightError, r.maxHeightError, r.surfaceMismatches,
+               r.biomeMismatches, r.coarseMs, r.exactMs);
+    }
+
+    void benchmarkMeshing() {
+        MeshingBenchmark::MeshingReport report = MeshingBenchmark::compareMeshingModes();
+        printf("Opaque meshing over %d chunks: per-face %zu verts / %zu KB / %.2fms, "
+               "greedy %zu verts / %zu KB / %.2fms\n",
+               report.chunks, report.perFaceVertices, report.perFaceBytes / 1024,
+               report.perFaceMs, report.greedyVertices, report.greedyBytes / 1024,
+               report.greedyMs);
+    }
+
+    void benchmarkCulling() {
+        MeshingBenchmark::FaceCullingReport report = MeshingBenchmark::compareFaceCulling();
+        printf("Opaque face culling over %d chunks: %zu faces, per-voxel %.2fms (%.1fM faces/s), "
+               "bitmask %.2fms (%.1fM faces/s)%s\n",
+               report.chunks, report.faces, report.perVoxelMs,
+               report.perVoxelFacesPerSec() / 1e6, report.bitmaskMs,
+               report.bitmaskFacesPerSec() / 1e6, report.matches ? "" : " MISMATCH");
+    }
+
+    void benchmarkQueues() {
+        for (const QueueBenchmark::Result& r : QueueBenchmark::run(100000)) {
+            printf("Queues, %2d producers: MPSC mutex %.1fM/s, lock-free %.1fM/s; "
+                   "MPMC mutex %.1fM/s, lock-free %.1fM/s\n",
+                   r.producers, r.mutexMpsc / 1e6, r.lockFreeMpsc / 1e6, r.mutexMpmc / 1e6,
+                   r.lockFreeMpmc / 1e6);
+        }
+    }
+
+    void benchmarkRegistry() {
+        for (const ChunkRegistryBenchmark::Result& r : ChunkRegistryBenchmark::run(1000000)) {
+            printf("Chunk lookups, %5d chunks x %d threads: map %.1fM/s, locked map %.1fM/s, "
+                   "registry %.1fM/s (old hash worst bucket %zu)\n",
+                   r.chunks, r.threads, r.unlockedMap / 1e6, r.mutexMap / 1e6, r.registry / 1e6,
+                   r.worstProbe);
+        }
+    }
+
+    void benchmarkLighting() {
+        LightingBenchmark::Result r = LightingBenchmark::run(6, 5);
+        printf("Sky light flood over %d chunks, %zu voxels: std::queue %.1fM voxels/s, "
+               "LightQueue %.1fM voxels/s%s\n",
+               r.chunks, r.voxels, r.dequeVoxelsPerSec / 1e6, r.packedVoxelsPerSec / 1e6,
+               r.matches ? "" : " MISMATCH");
+        printf("Sky light seeding: every lit voxel %.1fus/chunk (%zu nodes), beside covered "
+               "columns %.1fus/chunk (%zu nodes)\n",
+               r.packedMicrosPerChunk, r.voxels, r.seededMicrosPerChunk, r.seededNodes);
+
+        LightingBenchmark::EmitterRemoval removal = LightingBenchmark::removeAdjacentEmitter();
+        printf("Glowstone removed from beside a torch: %.1fus, torch light %s\n",
+               removal.removeMicros, removal.matches ? "intact" : "MISMATCH");
+    }
+
+    struct Benchmark {
+        const char* name;
+        void (*run)();
+        bool needsWorld; // Reads the chunks loadWorld publishes
+    };
+
+    constexpr Benchmark BENCHMARKS[] = {
+        {"noise", benchmarkNoise, false},
+        {"climate", benchmarkClimate, false},
+        {"meshing", benchmarkMeshing, true},
+        {"culling", benchmarkCulling, true},
+        {"queues", benchmarkQueues, false},
+        {"registry", benchmarkRegistry, false},
+        {"lighting", benchmarkLighting, true},
+    };
+} // namespace
+
+int main(int argc, char** argv) {
+    // A fixed seed so runs compare like for like
+    Settings::worldSeed = 1337;
+    ChunkHelper::initNoiseRenderer();
+    Renderer::initTintPalette();
+
+    auto selected = [&](const Benchmark& benchmark) {
+        if (argc < 2) return true;
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], benchmark.name) == 0) return true;
+        }
+        return false;
+    };
+
+    for (int i = 1; i < argc; i++) {
+        bool known = false;
+        for (const Benchmark& benchmark : BENCHMARKS) known |= strcmp(argv[i], benchmark.name) == 0;
+        if (known) continue;
+
+        fprintf(stderr, "Unknown benchmark '%s'. Available:", argv[i]);
+        for (const Benchmark& benchmark : BENCHMARKS) fprintf(stderr, " %s", benchmark.name);
+        fprintf(stderr, "\n");
+        return 1;
+    }
+
+    bool worldLoaded = false;
+    for (const Benchmark& benchmark : BENCHMARKS) {
+        if (!selected(benchmark)) continue;
+
+        if (benchmark.needsWorld && !worldLoaded) {
+            loadWorld(6);
+            worldLoaded = true;
+        }
+        benchmark.run();
+    }
+
+    return 0;
+}
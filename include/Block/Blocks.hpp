@@ -6,6 +6,7 @@
 #define REFACTOREDCLONE_BLOCKS_HPP
 
 #pragma once
+#include <array>
 #include <raylib.h>
 #include <unordered_map>
 
@@ -26,6 +27,8 @@ enum BlockIds {
     ID_GLOWSTONE
 };
 
+constexpr int BLOCK_ID_COUNT = ID_GLOWSTONE + 1;
+
 enum TextureTiles {
     GRASS_TOP_TILE = 0,
     GRASS_SIDE_TILE = 1,
@@ -155,7 +158,7 @@ inline Color getBlockFaceTint(BlockIds id, int face, int biome) {
 }
 // In Blocks.hpp - add these functions or a lookup table
 
-inline bool isBlockTranslucent(int blockId) {
+constexpr bool isBlockTranslucent(int blockId) {
     switch (blockId) {
         case ID_WATER:
         case ID_OAK_LEAF:
@@ -176,6 +179,19 @@ inline bool isBlockSolid(int blockId) {
     }
 }
 
+// Blocks light and hides the faces behind it
+constexpr bool isBlockOpaque(int blockId) {
+    return blockId != ID_AIR && !isBlockTranslucent(blockId);
+}
+
+// !isBlockOpaque for every id a section can store, so lighting's inner loops index instead of
+// branching
+inline constexpr std::array<bool, 256> BLOCK_TRANSMITS_LIGHT = [] {
+    std::array<bool, 256> table{};
+    for (int id = 0; id < 256; id++) table[id] = !isBlockOpaque(id);
+    return table;
+}();
+
 inline unsigned char getBlockAlpha(int blockId) {
     switch (blockId) {
         case ID_WATER:
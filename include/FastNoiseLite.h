@@ -53,6 +53,15 @@
 
 #include <cmath>
 
+// Batch grid sampling uses AVX2 kernels selected at runtime on x86 GCC/Clang builds
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FNL_BATCH_AVX2 1
+#define FNL_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define FNL_BATCH_AVX2 0
+#endif
+
 class FastNoiseLite
 {
 public:
@@ -339,6 +348,75 @@ public:
         }
     }
 
+    /// <summary>
+    /// Fills a countX * countY grid of 2D noise using current settings
+    /// </summary>
+    /// <remarks>
+    /// Output is row-major with x varying fastest:
+    /// out[j * countX + i] = GetNoise(xStart + i * step, yStart + j * step)
+    ///
+    /// OpenSimplex2S, Perlin and Cellular (no fractal or FBm) are evaluated 8 samples at a
+    /// time when the CPU supports AVX2, anything else uses the scalar path.
+    /// Both paths return the same values, unless the scalar code is built with FMA
+    /// contraction enabled (e.g. -march=native), which shifts the last bits.
+    /// </remarks>
+    void GetNoiseGrid2D(float* out, float xStart, float yStart, int countX, int countY, float step = 1) const
+    {
+#if FNL_BATCH_AVX2
+        if (CanBatch2D() && CpuHasAVX2())
+        {
+            for (int j = 0; j < countY; j++)
+            {
+                GenRow2DAVX2(out + j * countX, xStart, yStart + j * step, countX, step);
+            }
+            return;
+        }
+#endif
+        GetNoiseGrid2DScalar(out, xStart, yStart, countX, countY, step);
+    }
+
+    /// <summary>
+    /// Same as GetNoiseGrid2D but always takes the scalar path
+    /// </summary>
+    void GetNoiseGrid2DScalar(float* out, float xStart, float yStart, int countX, int countY, float step = 1) const
+    {
+        for (int j = 0; j < countY; j++)
+        {
+            float y = yStart + j * step;
+
+            for (int i = 0; i < countX; i++)
+            {
+                out[j * countX + i] = GetNoise(xStart + i * step, y);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Fills a countX * countY * countZ block of 3D noise using current settings
+    /// </summary>
+    /// <remarks>
+    /// Output has x varying fastest, then z, then y:
+    /// out[(j * countZ + k) * countX + i] = GetNoise(xStart + i * step, yStart + j * step, zStart + k * step)
+    /// </remarks>
+    void GetNoiseGrid3D(float* out, float xStart, float yStart, float zStart, int countX, int countY, int countZ, float step = 1) const
+    {
+        for (int j = 0; j < countY; j++)
+        {
+            float y = yStart + j * step;
+
+            for (int k = 0; k < countZ; k++)
+            {
+                float z = zStart + k * step;
+                float* row = out + (j * countZ + k) * countX;
+
+                for (int i = 0; i < countX; i++)
+                {
+                    row[i] = GetNoise(xStart + i * step, y, z);
+                }
+            }
+        }
+    }
+
 
     /// <summary>
     /// 2D warps the input position using current domain warp settings
@@ -2443,6 +2521,378 @@ private:
         yr += vy * warpAmp;
         zr += vz * warpAmp;
     }
+#if FNL_BATCH_AVX2
+    // Batch kernels
+    //
+    // Lane-for-lane ports of the scalar 2D functions above. Every operation is done in the
+    // same order as the scalar code and no FMA is used, so results match GetNoise bit for bit.
+
+    bool CanBatch2D() const
+    {
+        switch (mNoiseType)
+        {
+        case NoiseType_OpenSimplex2S:
+        case NoiseType_Perlin:
+        case NoiseType_Cellular:
+            return mFractalType != FractalType_Ridged && mFractalType != FractalType_PingPong;
+        default:
+            return false;
+        }
+    }
+
+    static bool CpuHasAVX2()
+    {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    FNL_AVX2_TARGET static __m256i FastFloorAVX2(__m256 f)
+    {
+        // (int)f truncates, then subtract one for negative inputs like FastFloor does
+        __m256 negative = _mm256_cmp_ps(f, _mm256_setzero_ps(), _CMP_LT_OQ);
+        return _mm256_add_epi32(_mm256_cvttps_epi32(f), _mm256_castps_si256(negative));
+    }
+
+    FNL_AVX2_TARGET static __m256i FastRoundAVX2(__m256 f)
+    {
+        __m256 positive = _mm256_cmp_ps(f, _mm256_setzero_ps(), _CMP_GE_OQ);
+        __m256 up = _mm256_add_ps(f, _mm256_set1_ps(0.5f));
+        __m256 down = _mm256_sub_ps(f, _mm256_set1_ps(0.5f));
+        return _mm256_cvttps_epi32(_mm256_blendv_ps(down, up, positive));
+    }
+
+    FNL_AVX2_TARGET static __m256 LerpAVX2(__m256 a, __m256 b, __m256 t)
+    {
+        return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+    }
+
+    FNL_AVX2_TARGET static __m256i HashAVX2(__m256i seed, __m256i xPrimed, __m256i yPrimed)
+    {
+        __m256i hash = _mm256_xor_si256(_mm256_xor_si256(seed, xPrimed), yPrimed);
+        return _mm256_mullo_epi32(hash, _mm256_set1_epi32(0x27d4eb2d));
+    }
+
+    FNL_AVX2_TARGET static __m256 GradCoordAVX2(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256 xd, __m256 yd)
+    {
+        __m256i hash = HashAVX2(seed, xPrimed, yPrimed);
+        hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+        hash = _mm256_and_si256(hash, _mm256_set1_epi32(127 << 1));
+
+        __m256 xg = _mm256_i32gather_ps(Lookup<float>::Gradients2D, hash, 4);
+        __m256 yg = _mm256_i32gather_ps(Lookup<float>::Gradients2D, _mm256_or_si256(hash, _mm256_set1_epi32(1)), 4);
+
+        return _mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg));
+    }
+
+    FNL_AVX2_TARGET static __m256 Falloff4AVX2(__m256 a)
+    {
+        __m256 a2 = _mm256_mul_ps(a, a);
+        return _mm256_mul_ps(a2, a2);
+    }
+
+    FNL_AVX2_TARGET static __m256 SingleOpenSimplex2SAVX2(__m256i seed, __m256 x, __m256 y)
+    {
+        const float SQRT3 = (float)1.7320508075688772935274463415059;
+        const float G2 = (3 - SQRT3) / 6;
+
+        const __m256i primeX = _mm256_set1_epi32(PrimeX);
+        const __m256i primeY = _mm256_set1_epi32(PrimeY);
+        const __m256 twoThirds = _mm256_set1_ps(2.0f / 3.0f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1);
+
+        __m256i i = FastFloorAVX2(x);
+        __m256i j = FastFloorAVX2(y);
+        __m256 xi = _mm256_sub_ps(x, _mm256_cvtepi32_ps(i));
+        __m256 yi = _mm256_sub_ps(y, _mm256_cvtepi32_ps(j));
+
+        i = _mm256_mullo_epi32(i, primeX);
+        j = _mm256_mullo_epi32(j, primeY);
+        __m256i i1 = _mm256_add_epi32(i, primeX);
+        __m256i j1 = _mm256_add_epi32(j, primeY);
+
+        __m256 t = _mm256_mul_ps(_mm256_add_ps(xi, yi), _mm256_set1_ps(G2));
+        __m256 x0 = _mm256_sub_ps(xi, t);
+        __m256 y0 = _mm256_sub_ps(yi, t);
+
+        __m256 a0 = _mm256_sub_ps(_mm256_sub_ps(twoThirds, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0));
+        __m256 value = _mm256_mul_ps(Falloff4AVX2(a0), GradCoordAVX2(seed, i, j, x0, y0));
+
+        __m256 a1 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))), t),
+                                  _mm256_add_ps(_mm256_set1_ps((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))), a0));
+        __m256 x1 = _mm256_sub_ps(x0, _mm256_set1_ps((float)(1 - 2 * G2)));
+        __m256 y1 = _mm256_sub_ps(y0, _mm256_set1_ps((float)(1 - 2 * G2)));
+        value = _mm256_add_ps(value, _mm256_mul_ps(Falloff4AVX2(a1), GradCoordAVX2(seed, i1, j1, x1, y1)));
+
+        // The scalar version picks two of six extra vertices with nested branches.
+        // Here both choices are made per lane with blends; the offsets are written as
+        // additions of the negated constants, which rounds identically.
+        __m256 xmyi = _mm256_sub_ps(xi, yi);
+        __m256 upper = _mm256_cmp_ps(t, _mm256_set1_ps(G2), _CMP_GT_OQ);
+
+        __m256 xPlus = _mm256_add_ps(xi, xmyi);
+        __m256 upperA = _mm256_cmp_ps(xPlus, one, _CMP_GT_OQ);
+        __m256 lowerA = _mm256_cmp_ps(xPlus, zero, _CMP_LT_OQ);
+        __m256 upperB = _mm256_cmp_ps(_mm256_sub_ps(yi, xmyi), one, _CMP_GT_OQ);
+        __m256 lowerB = _mm256_cmp_ps(yi, xmyi, _CMP_LT_OQ);
+
+        // Third vertex: (2, 1) / (0, 1) when upper, (-1, 0) / (1, 0) when lower
+        __m256 dx2 = _mm256_blendv_ps(
+            _mm256_blendv_ps(_mm256_set1_ps((float)(G2 - 1)), _mm256_set1_ps((float)(1 - G2)), lowerA),
+            _mm256_blendv_ps(_mm256_set1_ps((float)G2), _mm256_set1_ps((float)(3 * G2 - 2)), upperA), upper);
+        __m256 dy2 = _mm256_blendv_ps(
+            _mm256_blendv_ps(_mm256_set1_ps((float)G2), _mm256_set1_ps(-(float)G2), lowerA),
+            _mm256_blendv_ps(_mm256_set1_ps((float)(G2 - 1)), _mm256_set1_ps((float)(3 * G2 - 1)), upperA), upper);
+        __m256i di2 = _mm256_castps_si256(_mm256_blendv_ps(
+            _mm256_blendv_ps(_mm256_castsi256_ps(primeX), _mm256_castsi256_ps(_mm256_set1_epi32(-PrimeX)), lowerA),
+            _mm256_and_ps(_mm256_castsi256_ps(_mm256_set1_epi32(PrimeX << 1)), upperA), upper));
+        __m256i dj2 = _mm256_castps_si256(_mm256_and_ps(_mm256_castsi256_ps(primeY), upper));
+
+        // Fourth vertex: (1, 2) / (1, 0) when upper, (0, -1) / (0, 1) when lower
+        __m256 dx3 = _mm256_blendv_ps(
+            _mm256_blendv_ps(_mm256_set1_ps((float)G2), _mm256_set1_ps(-(float)G2), lowerB),
+            _mm256_blendv_ps(_mm256_set1_ps((float)(G2 - 1)), _mm256_set1_ps((float)(3 * G2 - 1)), upperB), upper);
+        __m256 dy3 = _mm256_blendv_ps(
+            _mm256_blendv_ps(_mm256_set1_ps((float)(G2 - 1)), _mm256_set1_ps(-(float)(G2 - 1)), lowerB),
+            _mm256_blendv_ps(_mm256_set1_ps((float)G2), _mm256_set1_ps((float)(3 * G2 - 2)), upperB), upper);
+        __m256i di3 = _mm256_castps_si256(_mm256_and_ps(_mm256_castsi256_ps(primeX), upper));
+        __m256i dj3 = _mm256_castps_si256(_mm256_blendv_ps(
+            _mm256_blendv_ps(_mm256_castsi256_ps(primeY), _mm256_castsi256_ps(_mm256_set1_epi32(-PrimeY)), lowerB),
+            _mm256_and_ps(_mm256_castsi256_ps(_mm256_set1_epi32(PrimeY << 1)), upperB), upper));
+
+        __m256 x2 = _mm256_add_ps(x0, dx2);
+        __m256 y2 = _mm256_add_ps(y0, dy2);
+        __m256 a2 = _mm256_sub_ps(_mm256_sub_ps(twoThirds, _mm256_mul_ps(x2, x2)), _mm256_mul_ps(y2, y2));
+        __m256 n2 = _mm256_mul_ps(Falloff4AVX2(a2),
+                                  GradCoordAVX2(seed, _mm256_add_epi32(i, di2), _mm256_add_epi32(j, dj2), x2, y2));
+        value = _mm256_add_ps(value, _mm256_and_ps(n2, _mm256_cmp_ps(a2, zero, _CMP_GT_OQ)));
+
+        __m256 x3 = _mm256_add_ps(x0, dx3);
+        __m256 y3 = _mm256_add_ps(y0, dy3);
+        __m256 a3 = _mm256_sub_ps(_mm256_sub_ps(twoThirds, _mm256_mul_ps(x3, x3)), _mm256_mul_ps(y3, y3));
+        __m256 n3 = _mm256_mul_ps(Falloff4AVX2(a3),
+                                  GradCoordAVX2(seed, _mm256_add_epi32(i, di3), _mm256_add_epi32(j, dj3), x3, y3));
+        value = _mm256_add_ps(value, _mm256_and_ps(n3, _mm256_cmp_ps(a3, zero, _CMP_GT_OQ)));
+
+        return _mm256_mul_ps(value, _mm256_set1_ps(18.24196194486065f));
+    }
+
+    FNL_AVX2_TARGET static __m256 InterpQuinticAVX2(__m256 t)
+    {
+        __m256 t3 = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+        __m256 inner = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6)), _mm256_set1_ps(15));
+        return _mm256_mul_ps(t3, _mm256_add_ps(_mm256_mul_ps(t, inner), _mm256_set1_ps(10)));
+    }
+
+    FNL_AVX2_TARGET static __m256 SinglePerlinAVX2(__m256i seed, __m256 x, __m256 y)
+    {
+        const __m256i primeX = _mm256_set1_epi32(PrimeX);
+        const __m256i primeY = _mm256_set1_epi32(PrimeY);
+
+        __m256i x0 = FastFloorAVX2(x);
+        __m256i y0 = FastFloorAVX2(y);
+
+        __m256 xd0 = _mm256_sub_ps(x, _mm256_cvtepi32_ps(x0));
+        __m256 yd0 = _mm256_sub_ps(y, _mm256_cvtepi32_ps(y0));
+        __m256 xd1 = _mm256_sub_ps(xd0, _mm256_set1_ps(1));
+        __m256 yd1 = _mm256_sub_ps(yd0, _mm256_set1_ps(1));
+
+        __m256 xs = InterpQuinticAVX2(xd0);
+        __m256 ys = InterpQuinticAVX2(yd0);
+
+        x0 = _mm256_mullo_epi32(x0, primeX);
+        y0 = _mm256_mullo_epi32(y0, primeY);
+        __m256i x1 = _mm256_add_epi32(x0, primeX);
+        __m256i y1 = _mm256_add_epi32(y0, primeY);
+
+        __m256 xf0 = LerpAVX2(GradCoordAVX2(seed, x0, y0, xd0, yd0), GradCoordAVX2(seed, x1, y0, xd1, yd0), xs);
+        __m256 xf1 = LerpAVX2(GradCoordAVX2(seed, x0, y1, xd0, yd1), GradCoordAVX2(seed, x1, y1, xd1, yd1), xs);
+
+        return _mm256_mul_ps(LerpAVX2(xf0, xf1, ys), _mm256_set1_ps(1.4247691104677813f));
+    }
+
+    FNL_AVX2_TARGET __m256 SingleCellularAVX2(__m256i seed, __m256 x, __m256 y) const
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+        __m256i xr = FastRoundAVX2(x);
+        __m256i yr = FastRoundAVX2(y);
+
+        __m256 distance0 = _mm256_set1_ps(1e10f);
+        __m256 distance1 = _mm256_set1_ps(1e10f);
+        __m256i closestHash = _mm256_setzero_si256();
+
+        __m256 cellularJitter = _mm256_set1_ps(0.43701595f * mCellularJitterModifier);
+
+        __m256i xPrimed = _mm256_mullo_epi32(_mm256_sub_epi32(xr, _mm256_set1_epi32(1)), _mm256_set1_epi32(PrimeX));
+        __m256i yPrimedBase = _mm256_mullo_epi32(_mm256_sub_epi32(yr, _mm256_set1_epi32(1)), _mm256_set1_epi32(PrimeY));
+
+        for (int xOffset = -1; xOffset <= 1; xOffset++)
+        {
+            __m256i yPrimed = yPrimedBase;
+            __m256 xCell = _mm256_cvtepi32_ps(_mm256_add_epi32(xr, _mm256_set1_epi32(xOffset)));
+
+            for (int yOffset = -1; yOffset <= 1; yOffset++)
+            {
+                __m256i hash = HashAVX2(seed, xPrimed, yPrimed);
+                __m256i idx = _mm256_and_si256(hash, _mm256_set1_epi32(255 << 1));
+
+                __m256 randX = _mm256_i32gather_ps(Lookup<float>::RandVecs2D, idx, 4);
+                __m256 randY = _mm256_i32gather_ps(Lookup<float>::RandVecs2D, _mm256_or_si256(idx, _mm256_set1_epi32(1)), 4);
+                __m256 yCell = _mm256_cvtepi32_ps(_mm256_add_epi32(yr, _mm256_set1_epi32(yOffset)));
+
+                __m256 vecX = _mm256_add_ps(_mm256_sub_ps(xCell, x), _mm256_mul_ps(randX, cellularJitter));
+                __m256 vecY = _mm256_add_ps(_mm256_sub_ps(yCell, y), _mm256_mul_ps(randY, cellularJitter));
+
+                __m256 newDistance;
+                switch (mCellularDistanceFunction)
+                {
+                default:
+                case CellularDistanceFunction_Euclidean:
+                case CellularDistanceFunction_EuclideanSq:
+                    newDistance = _mm256_add_ps(_mm256_mul_ps(vecX, vecX), _mm256_mul_ps(vecY, vecY));
+                    break;
+                case CellularDistanceFunction_Manhattan:
+                    newDistance = _mm256_add_ps(_mm256_andnot_ps(signMask, vecX), _mm256_andnot_ps(signMask, vecY));
+                    break;
+                case CellularDistanceFunction_Hybrid:
+                    newDistance = _mm256_add_ps(
+                        _mm256_add_ps(_mm256_andnot_ps(signMask, vecX), _mm256_andnot_ps(signMask, vecY)),
+                        _mm256_add_ps(_mm256_mul_ps(vecX, vecX), _mm256_mul_ps(vecY, vecY)));
+                    break;
+                }
+
+                // FastMax(FastMin(d1, n), d0): max/min return the second operand on ties, as the scalar ternaries do
+                distance1 = _mm256_max_ps(_mm256_min_ps(distance1, newDistance), distance0);
+                __m256 closer = _mm256_cmp_ps(newDistance, distance0, _CMP_LT_OQ);
+                distance0 = _mm256_blendv_ps(distance0, newDistance, closer);
+                closestHash = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(closestHash), _mm256_castsi256_ps(hash), closer));
+
+                yPrimed = _mm256_add_epi32(yPrimed, _mm256_set1_epi32(PrimeY));
+            }
+            xPrimed = _mm256_add_epi32(xPrimed, _mm256_set1_epi32(PrimeX));
+        }
+
+        if (mCellularDistanceFunction == CellularDistanceFunction_Euclidean && mCellularReturnType >= CellularReturnType_Distance)
+        {
+            distance0 = _mm256_sqrt_ps(distance0);
+
+            if (mCellularReturnType >= CellularReturnType_Distance2)
+            {
+                distance1 = _mm256_sqrt_ps(distance1);
+            }
+        }
+
+        const __m256 one = _mm256_set1_ps(1);
+        const __m256 half = _mm256_set1_ps(0.5f);
+
+        switch (mCellularReturnType)
+        {
+        case CellularReturnType_CellValue:
+            return _mm256_mul_ps(_mm256_cvtepi32_ps(closestHash), _mm256_set1_ps(1 / 2147483648.0f));
+        case CellularReturnType_Distance:
+            return _mm256_sub_ps(distance0, one);
+        case CellularReturnType_Distance2:
+            return _mm256_sub_ps(distance1, one);
+        case CellularReturnType_Distance2Add:
+            return _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(distance1, distance0), half), one);
+        case CellularReturnType_Distance2Sub:
+            return _mm256_sub_ps(_mm256_sub_ps(distance1, distance0), one);
+        case CellularReturnType_Distance2Mul:
+            return _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(distance1, distance0), half), one);
+        case CellularReturnType_Distance2Div:
+            return _mm256_sub_ps(_mm256_div_ps(distance0, distance1), one);
+        default:
+            return _mm256_setzero_ps();
+        }
+    }
+
+    FNL_AVX2_TARGET __m256 GenNoiseSingleAVX2(__m256i seed, __m256 x, __m256 y) const
+    {
+        switch (mNoiseType)
+        {
+        case NoiseType_OpenSimplex2S:
+            return SingleOpenSimplex2SAVX2(seed, x, y);
+        case NoiseType_Cellular:
+            return SingleCellularAVX2(seed, x, y);
+        case NoiseType_Perlin:
+            return SinglePerlinAVX2(seed, x, y);
+        default:
+            return _mm256_setzero_ps();
+        }
+    }
+
+    FNL_AVX2_TARGET __m256 GenFractalFBmAVX2(__m256 x, __m256 y) const
+    {
+        int seed = mSeed;
+        __m256 sum = _mm256_setzero_ps();
+        __m256 amp = _mm256_set1_ps(mFractalBounding);
+
+        const __m256 one = _mm256_set1_ps(1);
+        const __m256 two = _mm256_set1_ps(2);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 weightedStrength = _mm256_set1_ps(mWeightedStrength);
+        const __m256 lacunarity = _mm256_set1_ps(mLacunarity);
+        const __m256 gain = _mm256_set1_ps(mGain);
+
+        for (int i = 0; i < mOctaves; i++)
+        {
+            __m256 noise = GenNoiseSingleAVX2(_mm256_set1_epi32(seed++), x, y);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(noise, amp));
+            __m256 weight = _mm256_mul_ps(_mm256_min_ps(_mm256_add_ps(noise, one), two), half);
+            amp = _mm256_mul_ps(amp, LerpAVX2(one, weight, weightedStrength));
+
+            x = _mm256_mul_ps(x, lacunarity);
+            y = _mm256_mul_ps(y, lacunarity);
+            amp = _mm256_mul_ps(amp, gain);
+        }
+
+        return sum;
+    }
+
+    FNL_AVX2_TARGET void GenRow2DAVX2(float* out, float xStart, float y, int count, float step) const
+    {
+        const __m256 laneOffset = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256 frequency = _mm256_set1_ps(mFrequency);
+
+        for (int i = 0; i < count; i += 8)
+        {
+            __m256 laneIndex = _mm256_add_ps(_mm256_set1_ps((float)i), laneOffset);
+            __m256 vx = _mm256_add_ps(_mm256_set1_ps(xStart), _mm256_mul_ps(laneIndex, _mm256_set1_ps(step)));
+            __m256 vy = _mm256_set1_ps(y);
+
+            // TransformNoiseCoordinate
+            vx = _mm256_mul_ps(vx, frequency);
+            vy = _mm256_mul_ps(vy, frequency);
+            if (mNoiseType == NoiseType_OpenSimplex2S)
+            {
+                const float SQRT3 = (float)1.7320508075688772935274463415059;
+                const float F2 = 0.5f * (SQRT3 - 1);
+                __m256 t = _mm256_mul_ps(_mm256_add_ps(vx, vy), _mm256_set1_ps(F2));
+                vx = _mm256_add_ps(vx, t);
+                vy = _mm256_add_ps(vy, t);
+            }
+
+            __m256 noise = mFractalType == FractalType_FBm
+                ? GenFractalFBmAVX2(vx, vy)
+                : GenNoiseSingleAVX2(_mm256_set1_epi32(mSeed), vx, vy);
+
+            if (count - i >= 8)
+            {
+                _mm256_storeu_ps(out + i, noise);
+            }
+            else
+            {
+                float tail[8];
+                _mm256_storeu_ps(tail, noise);
+                for (int lane = 0; lane < count - i; lane++)
+                {
+                    out[i + lane] = tail[lane];
+                }
+            }
+        }
+    }
+#endif
 };
 
 template <>
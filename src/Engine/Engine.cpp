@@ -12,7 +12,6 @@
 
 #include "Biome/Biome.hpp"
 #include "Menu/Menu.hpp"
-#include "MultiThreading/MeshThreadPool.hpp"
 #include "Settings.hpp"
 
 Engine::Engine() {
@@ -22,14 +21,13 @@ Engine::Engine() {
     const auto time = std::chrono::high_resolution_clock::now();
     const int temp = static_cast<int>(time.time_since_epoch().count());
     SetRandomSeed(temp);
+    Renderer::initTintPalette();
     Renderer::initWaterShader();
-
-    int threads = std::clamp((int)std::thread::hardware_concurrency() - 1, 2, 6);
+    Renderer::initChunkShader();
 
     Settings::worldSeed = static_cast<int>(Settings::getSysTimeAsFloat());
 
-    Renderer::initChunkWorkers(threads); // Chunk generation threads
-    Renderer::initMeshThreadPool(2);     // Mesh building threads (2 is enough)
+    Renderer::initJobSystem(Settings::workerThreads);
 
     this->player = std::make_unique<Player>();
 
@@ -75,7 +73,7 @@ void Engine::update() {
 
         // GPU uploads - important for visual updates
         if (hasTimeBudget()) {
-            Renderer::uploadPendingMeshes();
+            Renderer::uploadPendingMeshes(this->player->getCamera());
         }
 
         // Water shader always updates (cheap)
@@ -86,7 +84,28 @@ void Engine::update() {
             Renderer::rebuildDirtyChunks();
         }
 
-        // Renderer::unloadChunks(this->player->getCamera());
+        // Arena compaction - lowest priority of all
+        if (hasTimeBudget()) {
+            Renderer::compactMeshArena();
+        }
+
+#ifndef NDEBUG
+        if (IsKeyPressed(KEY_F8)) {
+            printf("Chunk jobs: %d mesh builds, %d requests skipped, %d generated and dropped\n",
+                   Renderer::meshBuildCount.load(), Renderer::skippedChunkJobs.load(),
+                   Renderer::wastedChunkJobs.load());
+            printf("Chunks resident: %zu MB, %d unloaded\n",
+                   Renderer::residentChunkBytes / (1024 * 1024), Renderer::unloadedChunkCount);
+            printf("Rebuilds dropped as stale: %d\n", Renderer::staleRebuilds.load());
+            printf("Chunk mesh arena: %d pages of %d vertices, %zu vertices free, %d chunks "
+                   "remeshed to drain pages, %d oversized streams dropped\n",
+                   Renderer::meshArena.pageCount(), ChunkMeshArena::PAGE_VERTICES,
+                   Renderer::meshArena.freeVertices(), Renderer::compactionRemeshes,
+                   Renderer::droppedMeshStreams);
+        }
+#endif
+
+        Renderer::unloadChunks(this->player->getCamera());
         coords = std::to_string(this->player->getCamera().position.x) + ", " +
                  std::to_string(this->player->getCamera().position.y) + ", " +
                  std::to_string(this->player->getCamera().position.z);
@@ -114,13 +133,20 @@ void Engine::draw() const {
             int chunksLoaded = 0;
             {
                 std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
-                for (auto& [coord, chunk] : ChunkHelper::activeChunks) {
-                    if (chunk && chunk->loaded) chunksLoaded++;
+                for (Chunk* chunk : ChunkHelper::activeChunks) {
+                    if (chunk->loaded) chunksLoaded++;
                 }
             }
 
-            char progressText[64];
+            char progressText[128];
+#ifndef NDEBUG
+            snprintf(progressText, sizeof(progressText),
+                     "Chunks loaded: %d (mesh builds: %d, skipped: %d, wasted: %d)", chunksLoaded,
+                     Renderer::meshBuildCount.load(), Renderer::skippedChunkJobs.load(),
+                     Renderer::wastedChunkJobs.load());
+#else
             snprintf(progressText, sizeof(progressText), "Chunks loaded: %d", chunksLoaded);
+#endif
             int progressWidth = MeasureText(progressText, 20);
             DrawText(progressText, (GetScreenWidth() - progressWidth) / 2,
                      GetScreenHeight() / 2 + 30, 20, LIGHTGRAY);
@@ -172,7 +198,6 @@ Engine::~Engine() {
     // SaveFileData("./Worlds/world.dat", &header, sizeof(header));
 
     MainMenuUI::unload();
-    Renderer::shutdownMeshThreadPool(); // Shutdown mesh threads first
-    Renderer::shutdown();               // Then chunk workers
+    Renderer::shutdown(); // Stops the job system before freeing chunks
 }
 
@@ -0,0 +1,85 @@
+//
+// Packed BFS nodes and the ring buffer every lighting pass queues them in.
+//
+
+#ifndef REFACTOREDCLONE_LIGHTQUEUE_HPP
+#define REFACTOREDCLONE_LIGHTQUEUE_HPP
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <Chunk/Chunk.hpp>
+
+// One voxel in 32 bits: its index within its chunk in packedLight's [y][z][x] order (16 bits),
+// its light level (4 bits) and which chunk of a LightNeighborhood it's in (4 bits).
+struct LightNode {
+    static_assert(CHUNK_SIZE_X == 16 && CHUNK_SIZE_Z == 16 && CHUNK_SIZE_Y == 256,
+                  "LightNode packs a chunk-local index into 16 bits");
+
+    uint32_t bits = 0;
+
+    LightNode() = default;
+    LightNode(int x, int y, int z, int neighbor, int lightLevel)
+        : bits((uint32_t)x | (uint32_t)z << 4 | (uint32_t)y << 8 | (uint32_t)lightLevel << 16 |
+               (uint32_t)neighbor << 20) {}
+
+    static LightNode atIndex(int index, int neighbor, int lightLevel) {
+        return LightNode{(uint32_t)index | (uint32_t)lightLevel << 16 | (uint32_t)neighbor << 20};
+    }
+
+    int x() const { return bits & 0x0F; }
+    int z() const { return (bits >> 4) & 0x0F; }
+    int y() const { return (bits >> 8) & 0xFF; }
+    int index() const { return bits & 0xFFFF; } // Into a chunk's packedLight, flattened
+    uint8_t lightLevel() const { return (bits >> 16) & 0x0F; }
+    int neighbor() const { return bits >> 20; }
+
+    LightNode withLightLevel(int lightLevel) const {
+        return LightNode{(bits & ~0xF0000u) | (uint32_t)lightLevel << 16};
+    }
+
+private:
+    explicit LightNode(uint32_t bits) : bits(bits) {}
+};
+
+// FIFO of LightNodes in a power-of-two ring. It starts with room for a whole chunk and doubles if
+// a pass ever outruns it, then keeps that size, so a queue that's reused never allocates again.
+class LightQueue {
+public:
+    bool empty() const { return head == tail; }
+    size_t size() const { return tail - head; }
+
+    void push(LightNode node) {
+        if (tail - head == capacity) grow();
+        nodes[tail++ & (capacity - 1)] = node;
+    }
+
+    LightNode pop() { return nodes[head++ & (capacity - 1)]; }
+
+    void clear() { head = tail = 0; }
+
+private:
+    static constexpr size_t INITIAL_CAPACITY = CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z;
+
+    void grow() {
+        size_t bigger = capacity ? capacity * 2 : INITIAL_CAPACITY;
+        auto resized = std::make_unique<LightNode[]>(bigger);
+
+        // Unwrap in FIFO order so the indices stay valid against the new mask
+        for (size_t i = head; i != tail; i++) resized[i - head] = nodes[i & (capacity - 1)];
+        tail -= head;
+        head = 0;
+
+        nodes = std::move(resized);
+        capacity = bigger;
+    }
+
+    std::unique_ptr<LightNode[]> nodes;
+    size_t capacity = 0;
+    size_t head = 0;
+    size_t tail = 0;
+};
+
+#endif // REFACTOREDCLONE_LIGHTQUEUE_HPP
@@ -4,150 +4,292 @@
 
 #include "LightingSystem.hpp"
 
-void LightingSystem::calculateSkyLight(Chunk& chunk) {
-    memset(chunk.packedLight, 0, sizeof(chunk.packedLight));
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-    // Step 1: Downward pass
-    for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-            int lightLevel = 15;
+// Every pass on a thread reuses these, so once they've grown to fit, lighting doesn't allocate.
+// Passes that need two at once (removal feeding re-add, sky and block seeded together) take both.
+static thread_local LightQueue primaryQueue;
+static thread_local LightQueue secondaryQueue;
 
-            for (int y = CHUNK_SIZE_Y - 1; y >= 0; y--) {
-                BlockIds id = static_cast<BlockIds>(chunk.blockPosition[x][y][z]);
+static constexpr int FACE_DOWN = 5;
 
-                if (id == ID_AIR || isBlockTranslucent(id)) {
-                    chunk.setSkyLight(x, y, z, lightLevel);
-                } else {
-                    chunk.setSkyLight(x, y, z, 0);
-                    lightLevel = 0;
-                }
-            }
-        }
+LightNeighborhood::LightNeighborhood(const ChunkCoord& center) : center(center) {
+    for (int i = 0; i < COUNT; i++) {
+        chunks[i] = ChunkHelper::activeChunks.find({center.x + offsetX(i), center.z + offsetZ(i)});
     }
+}
 
-    int needsSpread = 0;
-    int underBlocks = 0;
-    for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                BlockIds id = static_cast<BlockIds>(chunk.blockPosition[x][y][z]);
-                if ((id == ID_AIR || isBlockTranslucent(id)) && chunk.getSkyLight(x, y, z) == 0) {
-                    needsSpread++;
-                }
-                if (id == ID_AIR && chunk.getSkyLight(x, y, z) == 0) {
-                    underBlocks++;
-                }
-            }
-        }
+LightNeighborhood::LightNeighborhood(Chunk& chunk) : center(chunk.chunkCoords) {
+    chunks[CENTER] = &chunk;
+}
+
+// The voxel one step along face f from node, carried into the next chunk across a border.
+// Null if that's above or below the world, outside the neighbourhood, or not loaded.
+static Chunk* step(const LightNeighborhood& area, LightNode node, int f, LightNode& out) {
+    int x = node.x() + dx1[f];
+    int y = node.y() + dy1[f];
+    int z = node.z() + dz1[f];
+    if (y < 0 || y >= CHUNK_SIZE_Y) return nullptr;
+
+    int neighbor = node.neighbor();
+    if (x < 0 || x >= CHUNK_SIZE_X || z < 0 || z >= CHUNK_SIZE_Z) {
+        int ox = LightNeighborhood::offsetX(neighbor) + (x < 0 ? -1 : x >= CHUNK_SIZE_X ? 1 : 0);
+        int oz = LightNeighborhood::offsetZ(neighbor) + (z < 0 ? -1 : z >= CHUNK_SIZE_Z ? 1 : 0);
+        if (ox < -1 || ox > 1 || oz < -1 || oz > 1) return nullptr;
+
+        // Sizes are powers of two, so this wraps -1 to the far edge and the far edge + 1 to 0
+        x &= CHUNK_SIZE_X - 1;
+        z &= CHUNK_SIZE_Z - 1;
+        neighbor = LightNeighborhood::indexOf(ox, oz);
     }
-#ifndef NDEBUG
-    printf("DEBUG: Air blocks with 0 light (need spread): %d, under blocks: %d\n", needsSpread,
-           underBlocks);
-#endif
 
-    propagateSkyLight(chunk);
+    out = LightNode(x, y, z, neighbor, 0);
+    return area.chunks[neighbor];
 }
 
-void LightingSystem::propagateSkyLight(Chunk& chunk) {
-    std::queue<LightNode> lightQueue;
+// A node's index uses BlockStorage's y-major layout, so it splits straight into a section and an
+// index within it
+static int blockAt(const Chunk& chunk, int index) {
+    return chunk.sections[index / SECTION_VOLUME].blocks.get(index % SECTION_VOLUME);
+}
 
-    for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                uint8_t sky = chunk.getSkyLight(x, y, z);
-                if (sky > 0) {
-                    lightQueue.push({x, y, z, chunk.chunkCoords.x, chunk.chunkCoords.z, sky});
-                }
+static uint8_t getLight(const Chunk& chunk, LightNode node, bool sky) {
+    uint8_t packed = reinterpret_cast<const uint8_t*>(chunk.packedLight)[node.index()];
+    return sky ? packed >> 4 : packed & 0x0F;
+}
+
+static void setLight(LightNeighborhood& area, LightNode node, bool sky, uint8_t level) {
+    uint8_t& packed =
+        reinterpret_cast<uint8_t*>(area.chunks[node.neighbor()]->packedLight)[node.index()];
+    packed = sky ? (packed & 0x0F) | (level << 4) : (packed & 0xF0) | level;
+    area.changed |= 1 << node.neighbor();
+}
+
+// Sky light keeps full strength straight down, as in the column pass; everything else fades
+static uint8_t spreadLevel(uint8_t level, int face, bool sky) {
+    return (sky && face == FACE_DOWN && level == 15) ? 15 : level - 1;
+}
+
+// Spread light outward from every queued voxel until nothing gets brighter. Returns how many
+// nodes were taken off the queue.
+static size_t propagateAdditions(LightNeighborhood& area, LightQueue& queue, bool sky) {
+    // Index offset of each face's neighbour within the same chunk
+    static constexpr int INDEX_STEP[6] = {-CHUNK_SIZE_X, CHUNK_SIZE_X, -1, 1,
+                                          CHUNK_SIZE_X * CHUNK_SIZE_Z,
+                                          -CHUNK_SIZE_X * CHUNK_SIZE_Z};
+    size_t visited = 0;
+    LightNode next;
+
+    while (!queue.empty()) {
+        LightNode node = queue.pop();
+        visited++;
+
+        // A seed can be queued before something else changes it, so read the level as it is now
+        Chunk& home = *area.chunks[node.neighbor()];
+        uint8_t level = getLight(home, node, sky);
+        if (level <= 1) continue;
+
+        // Away from every face of its chunk, each neighbour is a fixed index offset away
+        const int x = node.x();
+        const int y = node.y();
+        const int z = node.z();
+        const bool interior = x > 0 && x < CHUNK_SIZE_X - 1 && z > 0 && z < CHUNK_SIZE_Z - 1 &&
+                              y > 0 && y < CHUNK_SIZE_Y - 1;
+
+        for (int f = 0; f < 6; f++) {
+            Chunk* chunk;
+            if (interior) {
+                chunk = &home;
+                next = LightNode::atIndex(node.index() + INDEX_STEP[f], node.neighbor(), 0);
+            } else {
+                chunk = step(area, node, f, next);
+                if (!chunk) continue;
+            }
+            if (!BLOCK_TRANSMITS_LIGHT[blockAt(*chunk, next.index())]) continue;
+
+            uint8_t spread = spreadLevel(level, f, sky);
+            if (spread > getLight(*chunk, next, sky)) {
+                setLight(area, next, sky, spread);
+                queue.push(next);
             }
         }
     }
 
-#ifndef NDEBUG
-    printf("DEBUG: Seeded queue with %zu light sources\n", lightQueue.size());
-#endif
-
-    int iterations = 0;
+    return visited;
+}
 
-    while (!lightQueue.empty()) {
-        LightNode node = lightQueue.front();
-        lightQueue.pop();
-        iterations++;
+// Clear everything that was lit through a queued voxel, which must already be cleared and carry
+// the level it had. A brighter or equal neighbour has another source, so it goes to refill, as
+// does a cleared emitter once its own light is back.
+static void propagateRemovals(LightNeighborhood& area, LightQueue& queue, LightQueue& refill,
+                              bool sky) {
+    LightNode next;
 
-        if (node.lightLevel <= 1) continue;
+    while (!queue.empty()) {
+        LightNode node = queue.pop();
 
         for (int f = 0; f < 6; f++) {
-            int nx = node.x + dx1[f];
-            int ny = node.y + dy1[f];
-            int nz = node.z + dz1[f];
-
-            if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SIZE_Y || nz < 0 ||
-                nz >= CHUNK_SIZE_Z)
-                continue;
+            Chunk* chunk = step(area, node, f, next);
+            if (!chunk) continue;
 
-            BlockIds neighborId = static_cast<BlockIds>(chunk.blockPosition[nx][ny][nz]);
+            uint8_t level = getLight(*chunk, next, sky);
+            if (level == 0) continue;
 
-            if (neighborId != ID_AIR && !isBlockTranslucent(neighborId)) continue;
+            // Dimmer than node, or full sky light carried straight down from it
+            if (level < node.lightLevel() || (sky && f == FACE_DOWN && node.lightLevel() == 15)) {
+                setLight(area, next, sky, 0);
+                queue.push(next.withLightLevel(level));
 
-            uint8_t newLight = node.lightLevel - 1;
+                if (sky) continue;
 
-            if (newLight > chunk.getSkyLight(nx, ny, nz)) {
-                chunk.setSkyLight(nx, ny, nz, newLight);
-                lightQueue.push({nx, ny, nz, node.chunkX, node.chunkZ, newLight});
+                BlockIds id = static_cast<BlockIds>(blockAt(*chunk, next.index()));
+                uint8_t emission = LightingSystem::getBlockLightEmission(id);
+                if (emission > 0) {
+                    setLight(area, next, sky, emission);
+                    refill.push(next);
+                }
+            } else {
+                refill.push(next);
             }
         }
     }
+}
+
+void LightingSystem::fillSkyColumns(Chunk& chunk) {
+    constexpr size_t SLAB_BYTES = CHUNK_SIZE_X * CHUNK_SIZE_Z;
+
+    // Everything above the highest occupied section is open sky at full strength
+    const int openFromY = (chunk.getTopSection() + 1) * SECTION_SIZE;
+    memset(chunk.packedLight[0][0] + openFromY * SLAB_BYTES, 0xF0,
+           (CHUNK_SIZE_Y - openFromY) * SLAB_BYTES);
 
-#ifndef NDEBUG
-    printf("DEBUG: BFS completed after %d iterations\n", iterations);
+    // Below that, the heightmap says where each column's sky stops, so no blocks are read. A row
+    // of 16 columns is one compare of its heights against y and one 16-byte store.
+    for (int y = 0; y < openFromY; y++) {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            const uint16_t* heights = chunk.skyHeight[z];
+            uint8_t* row = chunk.packedLight[y][z];
+#ifdef __SSE2__
+            static_assert(CHUNK_SIZE_X == 16, "one row is two 8-lane height compares");
+            // Heights are at most 256, so the signed compare and saturating pack are exact
+            const __m128i above = _mm_set1_epi16((short)(y + 1));
+            __m128i lit0 = _mm_cmplt_epi16(_mm_loadu_si128((const __m128i*)heights), above);
+            __m128i lit1 = _mm_cmplt_epi16(_mm_loadu_si128((const __m128i*)(heights + 8)), above);
+            __m128i lit = _mm_and_si128(_mm_packs_epi16(lit0, lit1), _mm_set1_epi8((char)0xF0));
+            _mm_storeu_si128((__m128i*)row, lit);
+#else
+            for (int x = 0; x < CHUNK_SIZE_X; x++) row[x] = y >= heights[x] ? 0xF0 : 0;
 #endif
+        }
+    }
 }
 
-void LightingSystem::calculateBlockLight(Chunk& chunk) {
-    std::queue<LightNode> lightQueue;
-
-    for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                BlockIds id = static_cast<BlockIds>(chunk.blockPosition[x][y][z]);
-                uint8_t emission = getBlockLightEmission(id);
+void LightingSystem::calculateSkyLight(Chunk& chunk) {
+    fillSkyColumns(chunk);
 
-                if (emission > 0) {
-                    chunk.setBlockLight(x, y, z, emission);
-                    lightQueue.push({x, y, z, chunk.chunkCoords.x, chunk.chunkCoords.z, emission});
-                } else {
-                    chunk.setBlockLight(x, y, z, 0);
+#if LIGHTING_DIAGNOSTICS
+    int needsSpread = 0;
+    int underBlocks = 0;
+    for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                int id = chunk.getBlock(x, y, z);
+                if (BLOCK_TRANSMITS_LIGHT[id] && chunk.getSkyLight(x, y, z) == 0) {
+                    needsSpread++;
+                    if (id == ID_AIR) underBlocks++;
                 }
             }
         }
     }
+    printf("DEBUG: Air blocks with 0 light (need spread): %d, under blocks: %d\n", needsSpread,
+           underBlocks);
+#endif
 
-    while (!lightQueue.empty()) {
-        LightNode node = lightQueue.front();
-        lightQueue.pop();
+    propagateSkyLight(chunk);
+}
 
-        if (node.lightLevel <= 1) continue;
+size_t LightingSystem::spreadSkyLight(Chunk& chunk, LightQueue& queue) {
+    LightNeighborhood area(chunk);
+    return propagateAdditions(area, queue, true);
+}
 
-        for (int f = 0; f < 6; f++) {
-            int nx = node.x + dx1[f];
-            int ny = node.y + dy1[f];
-            int nz = node.z + dz1[f];
+size_t LightingSystem::propagateSkyLight(Chunk& chunk) {
+    LightQueue& lightQueue = primaryQueue;
+    lightQueue.clear();
+
+    // After the column pass a voxel can only brighten a neighbour in the column beside it, at a
+    // height where that column is still covered. Seed just those, which skips the open sky and
+    // the bulk of every exposed column.
+    for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (int x = 0; x < CHUNK_SIZE_X; x++) {
+            const int height = chunk.skyHeight[z][x];
+
+            int coveredTo = height;
+            for (int f = 0; f < 4; f++) {
+                int nx = x + dx1[f];
+                int nz = z + dz1[f];
+                if (nx < 0 || nx >= CHUNK_SIZE_X || nz < 0 || nz >= CHUNK_SIZE_Z) continue;
+                coveredTo = std::max<int>(coveredTo, chunk.skyHeight[nz][nx]);
+            }
 
-            if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SIZE_Y || nz < 0 ||
-                nz >= CHUNK_SIZE_Z)
-                continue;
+            for (int y = height; y < coveredTo; y++) {
+                lightQueue.push(LightNode(x, y, z, LightNeighborhood::CENTER, 15));
+            }
+        }
+    }
 
-            BlockIds neighborId = static_cast<BlockIds>(chunk.blockPosition[nx][ny][nz]);
+#if LIGHTING_DIAGNOSTICS
+    printf("DEBUG: Seeded queue with %zu light sources\n", lightQueue.size());
+#endif
+
+    size_t iterations = spreadSkyLight(chunk, lightQueue);
 
-            if (neighborId != ID_AIR && !isBlockTranslucent(neighborId)) continue;
+#if LIGHTING_DIAGNOSTICS
+    printf("DEBUG: BFS completed after %zu iterations\n", iterations);
+#endif
 
-            uint8_t newLight = node.lightLevel - 1;
+    return iterations;
+}
 
-            if (newLight > chunk.getBlockLight(nx, ny, nz)) {
-                chunk.setBlockLight(nx, ny, nz, newLight);
-                lightQueue.push({nx, ny, nz, node.chunkX, node.chunkZ, newLight});
+void LightingSystem::calculateBlockLight(Chunk& chunk) {
+    LightNeighborhood area(chunk);
+    LightQueue& lightQueue = primaryQueue;
+    lightQueue.clear();
+
+    uint8_t* light = chunk.packedLight[0][0];
+    for (size_t i = 0; i < sizeof(chunk.packedLight); i++) {
+        light[i] &= 0xF0;
+    }
+
+    // Only sections whose palette contains an emitter need scanning
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+        const ChunkSection& section = chunk.sections[s];
+        if (section.isEmpty()) continue;
+
+        bool hasEmitter = false;
+        for (uint8_t id : section.blocks.getPalette()) {
+            if (getBlockLightEmission(static_cast<BlockIds>(id)) > 0) hasEmitter = true;
+        }
+        if (!hasEmitter) continue;
+
+        for (int y = s * SECTION_SIZE; y < (s + 1) * SECTION_SIZE; y++) {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                    BlockIds id = static_cast<BlockIds>(chunk.getBlock(x, y, z));
+                    uint8_t emission = getBlockLightEmission(id);
+
+                    if (emission > 0) {
+                        chunk.setBlockLight(x, y, z, emission);
+                        lightQueue.push(LightNode(x, y, z, LightNeighborhood::CENTER, emission));
+                    }
+                }
             }
         }
     }
+
+    propagateAdditions(area, lightQueue, false);
 }
 
 uint8_t LightingSystem::getBlockLightEmission(BlockIds id) {
@@ -163,196 +305,129 @@ uint8_t LightingSystem::getBlockLightEmission(BlockIds id) {
     }
 }
 
-void LightingSystem::updateLightingAfterBlockBreak(Chunk& chunk, int x, int y, int z) {
-    int maxNeighborLight = 0;
-
-    for (int f = 0; f < 6; f++) {
-        int nx = x + dx1[f];
-        int ny = y + dy1[f];
-        int nz = z + dz1[f];
-
-        if (nx >= 0 && nx < CHUNK_SIZE_X && ny >= 0 && ny < CHUNK_SIZE_Y && nz >= 0 &&
-            nz < CHUNK_SIZE_Z) {
-            maxNeighborLight = std::max(maxNeighborLight, (int)chunk.getSkyLight(nx, ny, nz));
-        }
+// One channel of updateLightAfterEdit. origin is the edited voxel; emission is what the new block
+// gives off in this channel.
+static void relightAfterEdit(LightNeighborhood& area, LightNode origin, bool sky, uint8_t emission,
+                             bool transmits) {
+    LightQueue& removeQueue = primaryQueue;
+    LightQueue& addQueue = secondaryQueue;
+    removeQueue.clear();
+    addQueue.clear();
+    LightNode next;
+
+    const Chunk& originChunk = *area.chunks[origin.neighbor()];
+    uint8_t oldLevel = getLight(originChunk, origin, sky);
+    if (oldLevel > 0) {
+        setLight(area, origin, sky, 0);
+        removeQueue.push(origin.withLightLevel(oldLevel));
     }
+    propagateRemovals(area, removeQueue, addQueue, sky);
 
-    bool hasSkyAbove = true;
-    for (int checkY = y + 1; checkY < CHUNK_SIZE_Y; checkY++) {
-        BlockIds id = static_cast<BlockIds>(chunk.blockPosition[x][checkY][z]);
-        if (id != ID_AIR && !isBlockTranslucent(id)) {
-            hasSkyAbove = false;
-            break;
-        }
+    if (emission > 0) {
+        setLight(area, origin, sky, emission);
+        addQueue.push(origin);
     }
 
-    if (hasSkyAbove) {
-        chunk.setSkyLight(x, y, z, 15);
-    } else {
-        chunk.setSkyLight(x, y, z, std::max(0, maxNeighborLight - 1));
+    // An opening lets the light around it in
+    if (transmits) {
+        for (int f = 0; f < 6; f++) {
+            if (Chunk* chunk = step(area, origin, f, next)) {
+                if (getLight(*chunk, next, sky) > 0) addQueue.push(next);
+            }
+        }
+        if (sky && origin.y() == CHUNK_SIZE_Y - 1 && getLight(originChunk, origin, sky) < 15) {
+            setLight(area, origin, sky, 15);
+            addQueue.push(origin);
+        }
     }
 
-    std::queue<LightNode> lightQueue;
-    lightQueue.push({x, y, z, chunk.chunkCoords.x, chunk.chunkCoords.z, chunk.getSkyLight(x, y, z)});
+    propagateAdditions(area, addQueue, sky);
 }
 
-void LightingSystem::calculateChunkLighting(Chunk& chunk) {
-    calculateSkyLight(chunk);
-    calculateBlockLight(chunk);
+void LightingSystem::updateLightAfterEdit(int worldX, int worldY, int worldZ, BlockIds previous,
+                                          BlockIds current) {
+    if (worldY < 0 || worldY >= CHUNK_SIZE_Y) return;
 
-    propagateLightAcrossChunks(chunk);
-}
+    // A block that lets through the same light and emits the same can't change anything
+    const bool transmits = !isBlockOpaque(current);
+    if (isBlockOpaque(previous) == !transmits &&
+        getBlockLightEmission(previous) == getBlockLightEmission(current)) {
+        return;
+    }
 
-void LightingSystem::propagateLightAcrossChunks(Chunk& chunk) {
-    std::queue<LightNode> lightQueue;
+    LightNeighborhood area(ChunkHelper::worldToChunkCoord(worldX, worldZ));
+    if (!area.chunks[LightNeighborhood::CENTER]) return;
 
-    ChunkCoord coord = chunk.chunkCoords;
+    const LightNode origin(ChunkHelper::WorldToLocal(worldX), worldY,
+                           ChunkHelper::WorldToLocal(worldZ), LightNeighborhood::CENTER, 0);
+    relightAfterEdit(area, origin, true, 0, transmits);
+    relightAfterEdit(area, origin, false, getBlockLightEmission(current), transmits);
 
-    ChunkCoord neighbors[4] = {{coord.x - 1, coord.z},
-                               {coord.x + 1, coord.z},
-                               {coord.x, coord.z - 1},
-                               {coord.x, coord.z + 1}};
+    for (int i = 0; i < LightNeighborhood::COUNT; i++) {
+        if (!(area.changed & (1 << i))) continue;
 
-    if (ChunkHelper::activeChunks.contains(neighbors[0])) {
-        auto& leftChunk = ChunkHelper::activeChunks.at(neighbors[0]);
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                int neighborLight = leftChunk->getSkyLight(CHUNK_SIZE_X - 1, y, z);
-                if (neighborLight > 1 && neighborLight - 1 > chunk.getSkyLight(0, y, z)) {
-                    auto id = static_cast<BlockIds>(chunk.blockPosition[0][y][z]);
-                    if (id == ID_AIR || isBlockTranslucent(id)) {
-                        chunk.setSkyLight(0, y, z, neighborLight - 1);
-                        lightQueue.push({0, y, z, coord.x, coord.z, (uint8_t)(neighborLight - 1)});
-                    }
-                }
-            }
-        }
+        // Light is already final; the mesh just has to catch up
+        Chunk& chunk = *area.chunks[i];
+        chunk.dirty = true;
+        chunk.version = ++ChunkHelper::chunkEditCounter;
     }
+}
 
-    if (ChunkHelper::activeChunks.contains(neighbors[1])) {
-        auto& rightChunk = ChunkHelper::activeChunks.at(neighbors[1]);
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                int neighborLight = rightChunk->getSkyLight(0, y, z);
-                if (neighborLight > 1 &&
-                    neighborLight - 1 > chunk.getSkyLight(CHUNK_SIZE_X - 1, y, z)) {
-                    BlockIds id =
-                        static_cast<BlockIds>(chunk.blockPosition[CHUNK_SIZE_X - 1][y][z]);
-                    if (id == ID_AIR || isBlockTranslucent(id)) {
-                        chunk.setSkyLight(CHUNK_SIZE_X - 1, y, z, neighborLight - 1);
-                        lightQueue.push({CHUNK_SIZE_X - 1, y, z, coord.x, coord.z,
-                                         (uint8_t)(neighborLight - 1)});
-                    }
-                }
-            }
+uint16_t LightingSystem::connectChunk(const ChunkCoord& coord) {
+    LightNeighborhood area(coord);
+    if (!area.chunks[LightNeighborhood::CENTER]) return 0;
+
+    const Chunk& chunk = *area.chunks[LightNeighborhood::CENTER];
+    LightQueue& skyQueue = primaryQueue;
+    LightQueue& blockQueue = secondaryQueue;
+    skyQueue.clear();
+    blockQueue.clear();
+
+    // Seed whichever side of each border pair can brighten the other; the BFS carries it on from
+    // there, into the diagonal chunks as well
+    auto seed = [](LightQueue& queue, int innerLevel, int outerLevel, const Chunk& innerChunk,
+                   LightNode inner, const Chunk& outerChunk, LightNode outer) {
+        if (innerLevel > outerLevel + 1 &&
+            BLOCK_TRANSMITS_LIGHT[blockAt(outerChunk, outer.index())]) {
+            queue.push(inner);
+        } else if (outerLevel > innerLevel + 1 &&
+                   BLOCK_TRANSMITS_LIGHT[blockAt(innerChunk, inner.index())]) {
+            queue.push(outer);
         }
-    }
+    };
 
-    if (ChunkHelper::activeChunks.count(neighbors[2])) {
-        auto& frontChunk = ChunkHelper::activeChunks.at(neighbors[2]);
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int x = 0; x < CHUNK_SIZE_X; x++) {
-                int neighborLight = frontChunk->getSkyLight(x, y, CHUNK_SIZE_Z - 1);
-                if (neighborLight > 1 && neighborLight - 1 > chunk.getSkyLight(x, y, 0)) {
-                    BlockIds id = static_cast<BlockIds>(chunk.blockPosition[x][y][0]);
-                    if (id == ID_AIR || isBlockTranslucent(id)) {
-                        chunk.setSkyLight(x, y, 0, neighborLight - 1);
-                        lightQueue.push({x, y, 0, coord.x, coord.z, (uint8_t)(neighborLight - 1)});
-                    }
-                }
-            }
-        }
-    }
+    for (int f = 0; f < 4; f++) {
+        const int ox = dx1[f];
+        const int oz = dz1[f];
+        const int index = LightNeighborhood::indexOf(ox, oz);
+        const Chunk* neighbor = area.chunks[index];
+        if (!neighbor) continue;
 
-    if (ChunkHelper::activeChunks.count(neighbors[3])) {
-        auto& backChunk = ChunkHelper::activeChunks.at(neighbors[3]);
         for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int x = 0; x < CHUNK_SIZE_X; x++) {
-                int neighborLight = backChunk->getSkyLight(x, y, 0);
-                if (neighborLight > 1 &&
-                    neighborLight - 1 > chunk.getSkyLight(x, y, CHUNK_SIZE_Z - 1)) {
-                    BlockIds id =
-                        static_cast<BlockIds>(chunk.blockPosition[x][y][CHUNK_SIZE_Z - 1]);
-                    if (id == ID_AIR || isBlockTranslucent(id)) {
-                        chunk.setSkyLight(x, y, CHUNK_SIZE_Z - 1, neighborLight - 1);
-                        lightQueue.push({x, y, CHUNK_SIZE_Z - 1, coord.x, coord.z,
-                                         (uint8_t)(neighborLight - 1)});
-                    }
-                }
+            for (int t = 0; t < CHUNK_SIZE_X; t++) {
+                const int innerX = ox < 0 ? 0 : ox > 0 ? CHUNK_SIZE_X - 1 : t;
+                const int innerZ = oz < 0 ? 0 : oz > 0 ? CHUNK_SIZE_Z - 1 : t;
+                const int outerX = ox == 0 ? t : CHUNK_SIZE_X - 1 - innerX;
+                const int outerZ = oz == 0 ? t : CHUNK_SIZE_Z - 1 - innerZ;
+
+                // Most of a border is already in agreement, in both channels at once
+                uint8_t innerLight = chunk.packedLight[y][innerZ][innerX];
+                uint8_t outerLight = neighbor->packedLight[y][outerZ][outerX];
+                if (innerLight == outerLight) continue;
+
+                const LightNode inner(innerX, y, innerZ, LightNeighborhood::CENTER, 0);
+                const LightNode outer(outerX, y, outerZ, index, 0);
+                seed(skyQueue, innerLight >> 4, outerLight >> 4, chunk, inner, *neighbor, outer);
+                seed(blockQueue, innerLight & 0x0F, outerLight & 0x0F, chunk, inner, *neighbor,
+                     outer);
             }
         }
     }
 
-    propagateLightQueue(chunk, lightQueue);
-}
-
-static constexpr int dx[6] = {0, 0, -1, 1, 0, 0};
-static constexpr int dy[6] = {0, 0, 0, 0, 1, -1};
-static constexpr int dz[6] = {-1, 1, 0, 0, 0, 0};
-
-void LightingSystem::spreadLightFromNeighbor(Chunk& chunk, Chunk& neighbor, int edge) {
-#ifndef NDEBUG
-    printf("DEBUG: spreadLightFromNeighbor - chunk(%d,%d) edge=%d\n", chunk.chunkCoords.x,
-           chunk.chunkCoords.z, edge);
-#endif
-
-    std::queue<LightNode> lightQueue;
-    int edgeUpdates = 0;
-
-    switch (edge) {
-        case 0:
-            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-                for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                    int neighborLight = neighbor.getSkyLight(CHUNK_SIZE_X - 1, y, z);
-                    BlockIds id = static_cast<BlockIds>(chunk.blockPosition[0][y][z]);
-                    if ((id == ID_AIR || isBlockTranslucent(id)) && neighborLight > 1) {
-                        uint8_t newLight = neighborLight - 1;
-                        if (newLight > chunk.getSkyLight(0, y, z)) {
-                            chunk.setSkyLight(0, y, z, newLight);
-                            lightQueue.push({0, y, z, 0, 0, newLight});
-                            edgeUpdates++;
-                        }
-                    }
-                }
-            }
-            break;
-    }
-
-#ifndef NDEBUG
-    printf("DEBUG: Edge updates: %d, queue size: %zu\n", edgeUpdates, lightQueue.size());
-#endif
-
-    int propagated = 0;
-    while (!lightQueue.empty()) {
-        LightNode node = lightQueue.front();
-        lightQueue.pop();
+    propagateAdditions(area, skyQueue, true);
+    propagateAdditions(area, blockQueue, false);
 
-        if (node.lightLevel <= 1) continue;
-
-        for (int f = 0; f < 6; f++) {
-            int nx = node.x + dx[f];
-            int ny = node.y + dy[f];
-            int nz = node.z + dz[f];
-
-            if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SIZE_Y || nz < 0 ||
-                nz >= CHUNK_SIZE_Z)
-                continue;
-
-            BlockIds neighborId = static_cast<BlockIds>(chunk.blockPosition[nx][ny][nz]);
-            if (neighborId != ID_AIR && !isBlockTranslucent(neighborId)) continue;
-
-            uint8_t newLight = node.lightLevel - 1;
-            if (newLight > chunk.getSkyLight(nx, ny, nz)) {
-                chunk.setSkyLight(nx, ny, nz, newLight);
-                lightQueue.push({nx, ny, nz, 0, 0, newLight});
-                propagated++;
-            }
-        }
-    }
-
-#ifndef NDEBUG
-    printf("DEBUG: Total propagated: %d\n", propagated);
-#endif
+    return area.changed;
 }
 
 int LightingSystem::getWorldLightLevel(int worldX, int worldY, int worldZ) {
@@ -362,41 +437,13 @@ int LightingSystem::getWorldLightLevel(int worldX, int worldY, int worldZ) {
 
     ChunkCoord coord = ChunkHelper::worldToChunkCoord(worldX, worldZ);
 
-    auto it = ChunkHelper::activeChunks.find(coord);
-    if (it == ChunkHelper::activeChunks.end() || !it->second) {
+    Chunk* chunk = ChunkHelper::activeChunks.find(coord);
+    if (!chunk) {
         return 15; // Chunk not loaded, assume bright (or could return 0)
     }
 
     int localX = ChunkHelper::WorldToLocal(worldX);
     int localZ = ChunkHelper::WorldToLocal(worldZ);
 
-    return it->second->getLightLevel(localX, worldY, localZ);
-}
-
-void LightingSystem::propagateLightQueue(Chunk& chunk, std::queue<LightNode>& lightQueue) {
-    while (!lightQueue.empty()) {
-        LightNode node = lightQueue.front();
-        lightQueue.pop();
-
-        if (node.lightLevel <= 1) continue;
-
-        for (int f = 0; f < 6; f++) {
-            int nx = node.x + dx1[f];
-            int ny = node.y + dy1[f];
-            int nz = node.z + dz1[f];
-
-            if (nx < 0 || nx >= CHUNK_SIZE_X || ny < 0 || ny >= CHUNK_SIZE_Y || nz < 0 ||
-                nz >= CHUNK_SIZE_Z)
-                continue;
-
-            BlockIds neighborId = static_cast<BlockIds>(chunk.blockPosition[nx][ny][nz]);
-            if (neighborId != ID_AIR && !isBlockTranslucent(neighborId)) continue;
-
-            uint8_t newLight = node.lightLevel - 1;
-            if (newLight > chunk.getSkyLight(nx, ny, nz)) {
-                chunk.setSkyLight(nx, ny, nz, newLight);
-                lightQueue.push({nx, ny, nz, node.chunkX, node.chunkZ, newLight});
-            }
-        }
-    }
+    return chunk->getLightLevel(localX, worldY, localZ);
 }
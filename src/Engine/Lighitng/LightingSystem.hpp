@@ -8,40 +8,79 @@
 #include "Common.hpp"
 #include <Chunk/Chunk.hpp>
 #include <Block/Blocks.hpp>
+#include "LightQueue.hpp"
+
+// Per-chunk diagnostic scans and prints in the sky pass. On in debug builds; build with
+// -DLIGHTING_DIAGNOSTICS=0 to drop them there too, or =1 to keep them in release.
+#ifndef LIGHTING_DIAGNOSTICS
+#ifdef NDEBUG
+#define LIGHTING_DIAGNOSTICS 0
+#else
+#define LIGHTING_DIAGNOSTICS 1
+#endif
+#endif
 
 static const int dx1[6] = {0, 0, -1, 1, 0, 0};
 static const int dy1[6] = {0, 0, 0, 0, 1, -1};
 static const int dz1[6] = {-1, 1, 0, 0, 0, 0};
 
+// The 3x3 chunks around a centre chunk, indexed (dx + 1) * 3 + (dz + 1). Light that starts in the
+// centre chunk or on its borders fades out within 15 blocks, so it never leaves these nine and a
+// BFS over them converges in one pass.
+//
+// Light in a chunk that's already in activeChunks is only written through one of these, on the
+// main thread with activeChunksMutex held. Workers light a chunk before it's published and read
+// live light only through snapshots taken under the same lock.
+struct LightNeighborhood {
+    static constexpr int COUNT = 9;
+    static constexpr int CENTER = 4;
+
+    explicit LightNeighborhood(const ChunkCoord& center);
+
+    // Just chunk, at the centre; for lighting a chunk on its own before it's published
+    explicit LightNeighborhood(Chunk& chunk);
+
+    static int indexOf(int dx, int dz) { return (dx + 1) * 3 + (dz + 1); }
+    static int offsetX(int index) { return index / 3 - 1; }
+    static int offsetZ(int index) { return index % 3 - 1; }
+
+    ChunkCoord center;
+    Chunk* chunks[COUNT] = {}; // Null where a chunk isn't loaded
+    uint16_t changed = 0;      // Bit i set once chunks[i]'s light has been written
+};
+
 // In Renderer or separate LightingSystem class
 class LightingSystem {
     public:
-    // Light propagation queue
-    struct LightNode {
-        int x, y, z;
-        int chunkX, chunkZ;
-        uint8_t lightLevel;
-    };
-
-    private:
-    static void propagateLightQueue(Chunk& chunk, std::queue<LightNode>& lightQueue);
+    // Reset light to sky 15 down every column as far as its first opaque block, 0 elsewhere,
+    // from Chunk::skyHeight
+    static void fillSkyColumns(Chunk& chunk);
 
-    public:
     static void calculateSkyLight(Chunk& chunk);
 
-    static void propagateSkyLight(Chunk& chunk);
+    // Spread the column light sideways within the chunk, starting only from voxels beside a
+    // column that's covered at their height. Returns how many nodes the BFS took off its queue.
+    static size_t propagateSkyLight(Chunk& chunk);
+
+    // Spread sky light within chunk from every node in queue until nothing gets brighter.
+    // Returns how many nodes were taken off the queue.
+    static size_t spreadSkyLight(Chunk& chunk, LightQueue& queue);
 
     static void calculateBlockLight(Chunk& chunk);
 
     static uint8_t getBlockLightEmission(BlockIds id);
 
-    static void updateLightingAfterBlockBreak(Chunk& chunk, int x, int y, int z);
-
-    static void calculateChunkLighting(Chunk& chunk);
-
-    static void propagateLightAcrossChunks(Chunk& chunk);
-
-    static void spreadLightFromNeighbor(Chunk& chunk, Chunk& neighbor, int edge);
+    // Bring sky and block light up to date after the block at a world position changed from
+    // previous to current. A removal pass clears the light that depended on the old block, then
+    // a re-add pass refills it from the edge of what was cleared, crossing chunk borders as it
+    // goes. Chunks whose light changed are marked dirty. Caller holds activeChunksMutex.
+    static void updateLightAfterEdit(int worldX, int worldY, int worldZ, BlockIds previous,
+                                     BlockIds current);
+
+    // Carry light both ways across the borders between a newly published chunk, lit on its own,
+    // and whichever neighbours are loaded. The result doesn't depend on which chunk arrived first.
+    // Returns LightNeighborhood::changed. Caller holds activeChunksMutex.
+    static uint16_t connectChunk(const ChunkCoord& coord);
 
     static int getWorldLightLevel(int worldX, int worldY, int worldZ);
 
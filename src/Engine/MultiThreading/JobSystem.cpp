@@ -0,0 +1,144 @@
+//
+// Work-stealing job scheduler shared by chunk generation, lighting and meshing.
+//
+
+#include "JobSystem.hpp"
+
+#include <algorithm>
+
+thread_local int JobSystem::workerIndex = -1;
+
+JobSystem::JobSystem(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = std::max((int)std::thread::hardware_concurrency() - 1, 2);
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() { shutdown(); }
+
+JobSystem::JobHandle JobSystem::submit(std::function<void()> fn, JobPriority priority,
+                                       std::initializer_list<JobHandle> dependencies) {
+    auto job = std::make_shared<Job>();
+    job->fn = std::move(fn);
+    job->priority = priority;
+
+    for (const JobHandle& dependency : dependencies) {
+        if (!dependency) continue;
+
+        std::lock_guard<std::mutex> lock(dependency->mtx);
+        if (dependency->done) continue;
+
+        job->unfinishedDependencies++;
+        dependency->continuations.push_back(job);
+    }
+
+    // Drop submit's own hold; if every dependency already finished the job is ready now
+    if (--job->unfinishedDependencies == 0) enqueue(job);
+    return job;
+}
+
+void JobSystem::shutdown() {
+    running = false;
+    queuedJobs++;
+    queuedJobs.notify_all();
+
+    for (auto& t : threads) {
+        if (t.joinable()) t.join();
+    }
+    threads.clear();
+
+    for (auto& queue : queues) {
+        for (auto& jobs : queue->jobs) jobs.clear();
+    }
+    JobHandle discarded;
+    for (auto& queue : injected) {
+        while (queue.try_pop(discarded)) {
+        }
+    }
+    queuedJobs = 0;
+}
+
+void JobSystem::enqueue(JobHandle job) {
+    // Counted before it's visible so a worker that takes it never drives the count negative
+    queuedJobs++;
+
+    // A worker keeps follow-up work local, where its data is still in cache; anything from
+    // outside the pool goes through the injection queue for its priority
+    const int priority = (int)job->priority;
+    if (workerIndex >= 0 || !injected[priority].try_push(std::move(job))) {
+        int index = workerIndex >= 0 ? workerIndex : (int)(nextQueue++ % queues.size());
+        std::lock_guard<std::mutex> lock(queues[index]->mtx);
+        queues[index]->jobs[priority].push_back(std::move(job));
+    }
+
+    queuedJobs.notify_one();
+}
+
+bool JobSystem::findJob(int index, JobHandle& out) {
+    const int count = (int)queues.size();
+
+    for (int p = 0; p < JOB_PRIORITY_COUNT; p++) {
+        {
+            WorkerQueue& own = *queues[index];
+            std::lock_guard<std::mutex> lock(own.mtx);
+            if (!own.jobs[p].empty()) {
+                out = std::move(own.jobs[p].back());
+                own.jobs[p].pop_back();
+                return true;
+            }
+        }
+
+        if (injected[p].try_pop(out)) return true;
+
+        for (int i = 1; i < count; i++) {
+            WorkerQueue& victim = *queues[(index + i) % count];
+            std::lock_guard<std::mutex> lock(victim.mtx);
+            if (!victim.jobs[p].empty()) {
+                out = std::move(victim.jobs[p].front());
+                victim.jobs[p].pop_front();
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::run(const JobHandle& job) {
+    job->fn();
+    job->fn = nullptr;
+
+    std::vector<JobHandle> ready;
+    {
+        std::lock_guard<std::mutex> lock(job->mtx);
+        job->done = true;
+        ready.swap(job->continuations);
+    }
+
+    for (JobHandle& next : ready) {
+        if (--next->unfinishedDependencies == 0) enqueue(std::move(next));
+    }
+}
+
+void JobSystem::workerLoop(int index) {
+    workerIndex = index;
+
+    while (running) {
+        JobHandle job;
+        if (findJob(index, job)) {
+            queuedJobs--;
+            run(job);
+            continue;
+        }
+
+        // Returns at once if a job was queued since the search; enqueue notifies after counting
+        queuedJobs.wait(0);
+    }
+}
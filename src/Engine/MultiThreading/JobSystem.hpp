@@ -0,0 +1,91 @@
+//
+// Work-stealing job scheduler shared by chunk generation, lighting and meshing.
+//
+
+#ifndef REFACTOREDCLONE_JOBSYSTEM_HPP
+#define REFACTOREDCLONE_JOBSYSTEM_HPP
+
+#pragma once
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LockFreeQueue.hpp"
+
+// Served highest first. Within a priority, a worker takes its own newest job, then one submitted
+// from outside the pool, before stealing the oldest job from someone else.
+enum class JobPriority {
+    HIGH,   // Rebuilds after an edit, where the player is waiting on the result
+    NORMAL, // Lighting and meshing of newly generated chunks
+    LOW,    // Generation; request order is kept by ChunkRequestQueue
+};
+
+constexpr int JOB_PRIORITY_COUNT = 3;
+
+class JobSystem {
+public:
+    struct Job {
+        std::function<void()> fn;
+        JobPriority priority = JobPriority::NORMAL;
+
+        // Dependencies still running, plus one held by submit until the job is wired up
+        std::atomic<int> unfinishedDependencies{1};
+
+        std::mutex mtx; // Guards done and continuations
+        bool done = false;
+        std::vector<std::shared_ptr<Job>> continuations;
+    };
+
+    using JobHandle = std::shared_ptr<Job>;
+
+    // threadCount <= 0 picks one worker per core, leaving one for the main thread
+    explicit JobSystem(int threadCount);
+    ~JobSystem();
+
+    // Queue fn to run after every job in dependencies has finished. The handle can be passed as
+    // a dependency of later jobs, so gen -> light -> mesh reads as three chained submits.
+    JobHandle submit(std::function<void()> fn, JobPriority priority = JobPriority::NORMAL,
+                     std::initializer_list<JobHandle> dependencies = {});
+
+    // Stop the workers; jobs still queued never run
+    void shutdown();
+
+    int threadCount() const { return (int)threads.size(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mtx;
+        std::deque<JobHandle> jobs[JOB_PRIORITY_COUNT];
+    };
+
+    void workerLoop(int index);
+    void enqueue(JobHandle job);
+    bool findJob(int index, JobHandle& out);
+    void run(const JobHandle& job);
+
+    static constexpr size_t INJECT_CAPACITY = 4096;
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+
+    // Submits from off the pool (the main thread) land here rather than contending on a
+    // worker's deque lock; round robin takes over if one fills up
+    MpmcQueue<JobHandle> injected[JOB_PRIORITY_COUNT]{MpmcQueue<JobHandle>(INJECT_CAPACITY),
+                                                      MpmcQueue<JobHandle>(INJECT_CAPACITY),
+                                                      MpmcQueue<JobHandle>(INJECT_CAPACITY)};
+
+    // Idle workers sleep on this through std::atomic::wait until it goes non-zero
+    std::atomic<int> queuedJobs{0};
+    std::atomic<unsigned int> nextQueue{0};
+    std::atomic<bool> running{true};
+
+    // Index of the worker running on this thread, -1 off the pool
+    static thread_local int workerIndex;
+};
+
+#endif
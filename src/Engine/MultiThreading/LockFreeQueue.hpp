@@ -0,0 +1,148 @@
+//
+// Bounded lock-free queues for handing work between threads.
+//
+
+#ifndef REFACTOREDCLONE_LOCKFREEQUEUE_HPP
+#define REFACTOREDCLONE_LOCKFREEQUEUE_HPP
+
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Fixed-capacity ring after Dmitry Vyukov's bounded MPMC queue. Every slot carries a sequence
+// number saying whose turn it is on the current lap: equal to the slot's position when free for
+// a producer, one past it once filled for a consumer. Producers claim a position with one CAS on
+// tail and consumers with one CAS on head; with SingleConsumer the pop side is a plain store.
+//
+// push fails instead of blocking when the ring is full. Sleeping consumers wait on a futex-backed
+// std::atomic rather than a mutex and condition variable.
+template <typename T, bool SingleConsumer>
+class BoundedQueue {
+public:
+    // capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity)
+        : mask(std::bit_ceil(capacity < 2 ? 2 : capacity) - 1),
+          slots(std::make_unique<Slot[]>(mask + 1)) {
+        for (size_t i = 0; i <= mask; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Moves item in only on success, so a failed push leaves it with the caller
+    template <typename U>
+    bool try_push(U&& item) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        for (;;) {
+            slot = &slots[pos & mask];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Full: the consumer hasn't freed this slot from the last lap
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::forward<U>(item);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        pushes.fetch_add(1, std::memory_order_release);
+        pushes.notify_one();
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        Slot* slot;
+
+        for (;;) {
+            slot = &slots[pos & mask];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+            if (diff < 0) return false; // Empty, or the producer hasn't finished writing it
+
+            if constexpr (SingleConsumer) {
+                head.store(pos + 1, std::memory_order_relaxed);
+                break;
+            } else {
+                if (diff == 0) {
+                    if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else {
+                    pos = head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        out = std::move(slot->value);
+        slot->value = T{};
+        slot->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pop up to max items into out, returning how many were taken
+    template <typename OutputIt>
+    size_t pop_batch(OutputIt out, size_t max) {
+        size_t count = 0;
+        T item;
+        while (count < max && try_pop(item)) {
+            *out++ = std::move(item);
+            count++;
+        }
+        return count;
+    }
+
+    // Block until an item arrives or running goes false; false means nothing was popped
+    bool wait_pop(T& out, const std::atomic<bool>& running) {
+        for (;;) {
+            uint32_t seen = pushes.load(std::memory_order_acquire);
+            if (try_pop(out)) return true;
+            if (!running.load()) return false;
+            pushes.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    // Wake every thread in wait_pop so it can see running has gone false
+    void wakeAll() {
+        pushes.fetch_add(1, std::memory_order_release);
+        pushes.notify_all();
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value{};
+    };
+
+    const size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    // On their own cache lines so producers and consumers don't invalidate each other
+    alignas(CACHE_LINE) std::atomic<size_t> tail{0};
+    alignas(CACHE_LINE) std::atomic<size_t> head{0};
+    alignas(CACHE_LINE) std::atomic<uint32_t> pushes{0};
+};
+
+template <typename T>
+using MpmcQueue = BoundedQueue<T, false>;
+
+// Many producers, one consumer, e.g. workers handing results to the main thread
+template <typename T>
+using MpscQueue = BoundedQueue<T, true>;
+
+#endif
@@ -94,11 +94,6 @@ void Player::breakBlock() {
             ChunkCoord coord = ChunkHelper::worldToChunkCoord(x, z);
             ChunkHelper::markChunkDirty(coord);
 
-            auto &chunk = ChunkHelper::activeChunks.at(coord);
-            LightingSystem::calculateChunkLighting(*chunk);
-            LightingSystem::debugChunkLight(*chunk);
-
-
             // Check neighboring chunks if block is on edge
             int localX = ChunkHelper::WorldToLocal(x);
             int localZ = ChunkHelper::WorldToLocal(z);
@@ -240,14 +235,8 @@ void Player::placeBlock() {
     }
 }
 
-std::unique_ptr<Chunk> *Player::getCurrentPlayerChunk() {
-    ChunkCoord coord = Renderer::getPlayerChunkCoord(this->getCamera());
-
-    auto it = ChunkHelper::activeChunks.find(coord);
-    if (it != ChunkHelper::activeChunks.end()) {
-        return &it->second; // return pointer to unique_ptr
-    }
-    return nullptr;
+Chunk *Player::getCurrentPlayerChunk() {
+    return ChunkHelper::activeChunks.find(Renderer::getPlayerChunkCoord(this->getCamera()));
 }
 
 // In Player.cpp
@@ -544,8 +533,8 @@ void Player::trySpawn() {
         std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
 
         for (const auto& coord : requiredChunks) {
-            auto it = ChunkHelper::activeChunks.find(coord);
-            if (it == ChunkHelper::activeChunks.end() || !it->second || !it->second->loaded) {
+            Chunk* chunk = ChunkHelper::activeChunks.find(coord);
+            if (!chunk || !chunk->loaded) {
                 // Not all chunks ready
                 return;
             }
@@ -54,7 +54,7 @@ private:
     void placeBlock();
     int lastHitX{}, lastHitY{}, lastHitZ{};  // Track the block before the one we hit
 
-    std::unique_ptr<Chunk>* getCurrentPlayerChunk();
+    Chunk* getCurrentPlayerChunk();
 
     Camera3D camera{};
 };
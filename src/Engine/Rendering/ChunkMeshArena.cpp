@@ -0,0 +1,197 @@
+//
+// Pooled GPU storage for chunk meshes.
+//
+
+#include "ChunkMeshArena.hpp"
+
+#include <iterator>
+#include <rlgl.h>
+
+ChunkGpuMesh ChunkMeshArena::upload(const ChunkMeshBuffers& buf) {
+    ChunkGpuMesh mesh = allocate((int)buf.vertices.size());
+    if (mesh.isValid()) write(mesh, 0, buf.vertices.data(), mesh.vertexCount);
+    return mesh;
+}
+
+ChunkGpuMesh ChunkMeshArena::allocate(int vertexCount) {
+    ChunkGpuMesh mesh;
+    if (vertexCount == 0 || vertexCount > PAGE_VERTICES) return mesh;
+
+    if (!allocateRange(vertexCount, mesh.page, mesh.firstVertex)) return mesh;
+    mesh.vertexCount = vertexCount;
+    return mesh;
+}
+
+void ChunkMeshArena::write(const ChunkGpuMesh& mesh, int offset, const PackedVertex* vertices,
+                           int count) {
+    rlUpdateVertexBuffer(pages[mesh.page].vboId, vertices, count * (int)sizeof(PackedVertex),
+                         (mesh.firstVertex + offset) * (int)sizeof(PackedVertex));
+}
+
+void ChunkMeshArena::release(ChunkGpuMesh& mesh) {
+    if (!mesh.isValid()) {
+        mesh = {};
+        return;
+    }
+
+    Page& page = pages[mesh.page];
+    int start = mesh.firstVertex;
+    int length = mesh.vertexCount;
+
+    // Merge with the free runs on either side so the page doesn't splinter
+    auto next = page.freeRanges.lower_bound(start);
+    if (next != page.freeRanges.end() && start + length == next->first) {
+        length += next->second;
+        next = page.freeRanges.erase(next);
+    }
+    if (next != page.freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == start) {
+            start = prev->first;
+            length += prev->second;
+            page.freeRanges.erase(prev);
+        }
+    }
+    page.freeRanges[start] = length;
+    page.usedVertices -= mesh.vertexCount;
+
+    // Keep the first page around; later ones go back to the driver once empty
+    if (page.usedVertices == 0 && mesh.page > 0) {
+        destroyPage(page);
+        if (mesh.page == draining) draining = -1;
+    }
+
+    mesh = {};
+}
+
+void ChunkMeshArena::bindPage(int page) const { rlEnableVertexArray(pages[page].vaoId); }
+
+void ChunkMeshArena::draw(const ChunkGpuMesh& mesh) const {
+    // Indices in the shared buffer are page-absolute, so offset into it rather than the vertices
+    rlDrawVertexArrayElements(mesh.firstVertex / 4 * 6, mesh.vertexCount / 4 * 6, 0);
+}
+
+void ChunkMeshArena::unload() {
+    for (Page& page : pages) destroyPage(page);
+    pages.clear();
+    draining = -1;
+
+    if (quadIndexBuffer != 0) {
+        rlUnloadVertexBuffer(quadIndexBuffer);
+        quadIndexBuffer = 0;
+    }
+}
+
+int ChunkMeshArena::pageCount() const {
+    int count = 0;
+    for (const Page& page : pages) count += page.vaoId != 0;
+    return count;
+}
+
+size_t ChunkMeshArena::usedVertices() const {
+    size_t total = 0;
+    for (const Page& page : pages) total += page.usedVertices;
+    return total;
+}
+
+size_t ChunkMeshArena::freeVertices() const {
+    size_t total = 0;
+    for (const Page& page : pages) {
+        if (page.vaoId != 0) total += PAGE_VERTICES - page.usedVertices;
+    }
+    return total;
+}
+
+int ChunkMeshArena::drainingPage(float maxFill) {
+    if (draining >= 0) return draining;
+
+    int emptiest = -1;
+    for (int p = 1; p < (int)pages.size(); p++) {
+        if (pages[p].vaoId == 0 || pages[p].usedVertices > PAGE_VERTICES * maxFill) continue;
+        if (emptiest < 0 || pages[p].usedVertices < pages[emptiest].usedVertices) emptiest = p;
+    }
+    if (emptiest < 0) return -1;
+
+    // Free space is split into ranges, so ask for twice the room; if the meshes didn't fit they
+    // would only open a new page
+    const size_t elsewhere = freeVertices() - (PAGE_VERTICES - pages[emptiest].usedVertices);
+    if (elsewhere < 2 * (size_t)pages[emptiest].usedVertices) return -1;
+
+    draining = emptiest;
+    return draining;
+}
+
+bool ChunkMeshArena::allocateRange(int vertexCount, int& page, int& firstVertex) {
+    for (int p = 0; p < (int)pages.size(); p++) {
+        if (pages[p].vaoId == 0 || p == draining) continue;
+
+        auto& freeRanges = pages[p].freeRanges;
+        for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+            if (it->second < vertexCount) continue;
+
+            page = p;
+            firstVertex = it->first;
+
+            int remainingStart = it->first + vertexCount;
+            int remaining = it->second - vertexCount;
+            freeRanges.erase(it);
+            if (remaining > 0) freeRanges[remainingStart] = remaining;
+
+            pages[p].usedVertices += vertexCount;
+            return true;
+        }
+    }
+
+    page = createPage();
+    firstVertex = 0;
+
+    Page& fresh = pages[page];
+    fresh.freeRanges.clear();
+    if (vertexCount < PAGE_VERTICES) fresh.freeRanges[vertexCount] = PAGE_VERTICES - vertexCount;
+    fresh.usedVertices = vertexCount;
+    return true;
+}
+
+int ChunkMeshArena::createPage() {
+    if (quadIndexBuffer == 0) {
+        std::vector<unsigned short> indices(PAGE_VERTICES / 4 * 6);
+        for (int q = 0; q < PAGE_VERTICES / 4; q++) {
+            const unsigned short v = (unsigned short)(q * 4);
+            unsigned short* quad = &indices[q * 6];
+            quad[0] = v;
+            quad[1] = v + 2;
+            quad[2] = v + 1;
+            quad[3] = v;
+            quad[4] = v + 3;
+            quad[5] = v + 2;
+        }
+        quadIndexBuffer = rlLoadVertexBufferElement(
+            indices.data(), (int)(indices.size() * sizeof(unsigned short)), false);
+    }
+
+    // Reuse a slot freed by destroyPage so existing page numbers stay put
+    int index = 0;
+    while (index < (int)pages.size() && pages[index].vaoId != 0) index++;
+    if (index == (int)pages.size()) pages.emplace_back();
+
+    Page& page = pages[index];
+    page.vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(page.vaoId);
+
+    page.vboId = rlLoadVertexBuffer(nullptr, PAGE_VERTICES * (int)sizeof(PackedVertex), true);
+    // Four unnormalized shorts; the shader unpacks the bit fields
+    rlSetVertexAttribute(0, 4, RL_UNSIGNED_SHORT, false, sizeof(PackedVertex), 0);
+    rlEnableVertexAttribute(0);
+
+    // The element buffer binding is VAO state, so every page picks up the shared one here
+    rlEnableVertexBufferElement(quadIndexBuffer);
+
+    rlDisableVertexArray();
+    return index;
+}
+
+void ChunkMeshArena::destroyPage(Page& page) {
+    if (page.vaoId != 0) rlUnloadVertexArray(page.vaoId);
+    if (page.vboId != 0) rlUnloadVertexBuffer(page.vboId);
+    page = {};
+}
@@ -0,0 +1,85 @@
+//
+// Pooled GPU storage for chunk meshes.
+//
+
+#ifndef REFACTOREDCLONE_CHUNKMESHARENA_HPP
+#define REFACTOREDCLONE_CHUNKMESHARENA_HPP
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "Chunk/Chunk.hpp"
+
+// Sub-allocates chunk meshes from a few large vertex buffers ("pages") instead of giving every
+// mesh its own VAO and buffers. Each page owns one VAO; all pages share a single index buffer
+// holding the quad pattern (0, 2, 1) (0, 3, 2) for a full page, so meshes store no indices and
+// a mesh starting at vertex v draws from index v / 4 * 6.
+//
+// 16-bit indices address at most 65536 vertices, which sets the page size. Free space is kept
+// per page as address-ordered ranges that merge with their neighbours on release, and
+// allocation is first-fit by address, so churn settles live meshes into the low pages. Pages
+// that empty out are handed back to the driver.
+//
+// Unloads can still leave a page holding a few meshes. The arena can't move them itself, since
+// their vertices only exist on the GPU once uploaded, so a sparse page is drained instead: it
+// takes no new allocations while the renderer remeshes the chunks in it, and the fresh meshes
+// land in the other pages until it empties and is freed.
+//
+// Main thread only: every call touches GL state.
+class ChunkMeshArena {
+public:
+    static constexpr int PAGE_VERTICES = 65536;
+
+    // Allocate space for buf and copy its vertices in. Returns an invalid mesh for an empty
+    // buffer or one larger than a page.
+    ChunkGpuMesh upload(const ChunkMeshBuffers& buf);
+
+    // Reserve space for vertexCount vertices without filling it, so a large mesh can be
+    // written over several frames. Same failure cases as upload.
+    ChunkGpuMesh allocate(int vertexCount);
+
+    // Copy count vertices to position offset within mesh's space
+    void write(const ChunkGpuMesh& mesh, int offset, const PackedVertex* vertices, int count);
+
+    // Return mesh's space to its page and reset it
+    void release(ChunkGpuMesh& mesh);
+
+    // Bind the VAO that mesh draws from
+    void bindPage(int page) const;
+
+    // Issue the draw for mesh; its page must be bound
+    void draw(const ChunkGpuMesh& mesh) const;
+
+    // Free every page and the shared index buffer
+    void unload();
+
+    int pageCount() const;
+    size_t usedVertices() const;
+
+    // Vertices free in the live pages, including any that slivers between meshes leave unusable
+    size_t freeVertices() const;
+
+    // The page being drained, picking one if none is: the emptiest after the first that is under
+    // maxFill full and whose meshes fit easily in the other pages' free space. -1 if none is.
+    int drainingPage(float maxFill);
+
+private:
+    struct Page {
+        unsigned int vaoId = 0;
+        unsigned int vboId = 0;
+        int usedVertices = 0;
+        // First vertex -> length of each free run
+        std::map<int, int> freeRanges;
+    };
+
+    bool allocateRange(int vertexCount, int& page, int& firstVertex);
+    int createPage();
+    void destroyPage(Page& page);
+
+    std::vector<Page> pages;
+    unsigned int quadIndexBuffer = 0;
+    int draining = -1; // Skipped by allocateRange until it empties
+};
+
+#endif // REFACTOREDCLONE_CHUNKMESHARENA_HPP
@@ -8,7 +8,12 @@
 #include "Common.hpp"
 #include "../Engine/Settings.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <climits>
 #include <iostream>
+#include <iterator>
 #include <ostream>
 #include <ranges>
 #include <raylib.h>
@@ -19,294 +24,465 @@
 #include <unordered_set>
 
 #include "../Lighitng/LightingSystem.hpp"
-#include "../MultiThreading/MeshThreadPool.hpp"
 
 constexpr float TILE_WIDTH = 160.0f;
 constexpr float TILE_HEIGHT = 160.0f;
 constexpr float ATLAS_WIDTH = 160.0f;
 constexpr float ATLAS_HEIGHT = 64000.0f;
 
+// Corner order per face; quads are indexed (0, 2, 1) (0, 3, 2)
+static const Vector3 FACE_VERTS[6][4] = {
+    {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}}, // Front (-Z)
+    {{1, 0, 1}, {0, 0, 1}, {0, 1, 1}, {1, 1, 1}}, // Back (+Z)
+    {{0, 0, 1}, {0, 0, 0}, {0, 1, 0}, {0, 1, 1}}, // Left (-X)
+    {{1, 0, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 0}}, // Right (+X)
+    {{0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}}, // Top (+Y)
+    {{0, 0, 1}, {1, 0, 1}, {1, 0, 0}, {0, 0, 0}}  // Bottom (-Y)
+};
+
+static const Vector3 FACE_NORMALS[6] = {{0, 0, -1}, {0, 0, 1}, {-1, 0, 0},
+                                        {1, 0, 0},  {0, 1, 0}, {0, -1, 0}};
+
+// Per face: the axis along the normal, and the in-plane axes the u and v texcoords run along
+static const int FACE_NORMAL_AXIS[6] = {2, 2, 0, 0, 1, 1};
+static const int FACE_U_AXIS[6] = {0, 0, 2, 2, 0, 0};
+static const int FACE_V_AXIS[6] = {1, 1, 1, 1, 2, 2};
+
+// blockTextureDefs is fixed at startup, so index it by id once instead of hashing per face
+static const BlockTextureDef* findBlockDef(int id) {
+    static const auto table = [] {
+        std::array<const BlockTextureDef*, 256> defs{};
+        for (const auto& [blockId, def] : blockTextureDefs) defs[blockId] = &def;
+        return defs;
+    }();
+    return table[id];
+}
+
 Texture2D Renderer::textureAtlas = {};
-std::vector<std::thread> Renderer::workers;
+std::atomic<int> Renderer::meshBuildCount = 0;
+std::unique_ptr<JobSystem> Renderer::jobs;
 
 // Cached frustum planes for per-frame culling optimization
 Plane Renderer::cachedFrustumPlanes[6] = {};
 bool Renderer::frustumPlanesValid = false;
 
-NeighborEdgeData Renderer::cacheNeighborEdges(const ChunkCoord& coord) {
-    NeighborEdgeData data;
-    auto it = ChunkHelper::activeChunks.find({coord.x - 1, coord.z});
-    if (it != ChunkHelper::activeChunks.end() && it->second) {
-        data.hasNegX = true;
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                data.setBlockNegX(y, z, it->second->blockPosition[CHUNK_SIZE_X - 1][y][z]);
-                data.setLightNegX(y, z, it->second->getLightLevel(CHUNK_SIZE_X - 1, y, z));
-            }
-        }
-    }
+void NeighborhoodSnapshot::clear() {
+    std::fill_n(blocks.get(), VOLUME, ID_AIR);
+    std::fill_n(light.get(), VOLUME, 15);
+    // Below the world is dark
+    std::fill_n(light.get(), LAYER, 0);
 
-    it = ChunkHelper::activeChunks.find({coord.x + 1, coord.z});
-    if (it != ChunkHelper::activeChunks.end() && it->second) {
-        data.hasPosX = true;
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                data.setBlockPosX(y, z, it->second->blockPosition[0][y][z]);
-                data.setLightPosX(y, z, it->second->getLightLevel(0, y, z));
-            }
-        }
-    }
+    hasNegX = hasPosX = hasNegZ = hasPosZ = false;
+}
 
-    it = ChunkHelper::activeChunks.find({coord.x, coord.z - 1});
-    if (it != ChunkHelper::activeChunks.end() && it->second) {
-        data.hasNegZ = true;
-        for (int x = 0; x < CHUNK_SIZE_X; x++) {
-            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-                data.setBlockNegZ(x, y, it->second->blockPosition[x][y][CHUNK_SIZE_Z - 1]);
-                data.setLightNegZ(x, y, it->second->getLightLevel(x, y, CHUNK_SIZE_Z - 1));
+void NeighborhoodSnapshot::copyColumns(const Chunk& src, int srcX, int srcZ, int dstX, int dstZ,
+                                       int sizeX, int sizeZ) {
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+        const BlockStorage& storage = src.sections[s].blocks;
+
+        for (int ly = 0; ly < SECTION_SIZE; ly++) {
+            int y = s * SECTION_SIZE + ly;
+            for (int z = 0; z < sizeZ; z++) {
+                uint8_t* blockRow = &blocks[index(dstX, y, dstZ + z)];
+                uint8_t* lightRow = &light[index(dstX, y, dstZ + z)];
+                const uint8_t* packedRow = &src.packedLight[y][srcZ + z][srcX];
+
+                for (int x = 0; x < sizeX; x++) {
+                    blockRow[x] = storage.get(srcX + x, ly, srcZ + z);
+                    lightRow[x] = std::max(packedRow[x] >> 4, packedRow[x] & 0x0F);
+                }
             }
         }
     }
+}
 
-    it = ChunkHelper::activeChunks.find({coord.x, coord.z + 1});
-    if (it != ChunkHelper::activeChunks.end() && it->second) {
-        data.hasPosZ = true;
-        for (int x = 0; x < CHUNK_SIZE_X; x++) {
-            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-                data.setBlockPosZ(x, y, it->second->blockPosition[x][y][0]);
-                data.setLightPosZ(x, y, it->second->getLightLevel(x, y, 0));
+NeighborhoodSnapshot& Renderer::snapshotNeighborhood(const Chunk& chunk) {
+    // One buffer per meshing thread, reused across jobs
+    static thread_local NeighborhoodSnapshot snapshot;
+
+    snapshot.clear();
+    snapshot.copyColumns(chunk, 0, 0, 0, 0, CHUNK_SIZE_X, CHUNK_SIZE_Z);
+
+    const ChunkCoord coord = chunk.chunkCoords;
+    for (int ox = -1; ox <= 1; ox++) {
+        for (int oz = -1; oz <= 1; oz++) {
+            if (ox == 0 && oz == 0) continue;
+
+            const Chunk* neighbor = ChunkHelper::activeChunks.find({coord.x + ox, coord.z + oz});
+            if (!neighbor) continue;
+
+            // Per axis: the neighbour's far edge for -1, its whole width for 0, its near edge for +1
+            int srcX = ox < 0 ? CHUNK_SIZE_X - 1 : 0;
+            int srcZ = oz < 0 ? CHUNK_SIZE_Z - 1 : 0;
+            int dstX = ox < 0 ? -1 : ox > 0 ? CHUNK_SIZE_X : 0;
+            int dstZ = oz < 0 ? -1 : oz > 0 ? CHUNK_SIZE_Z : 0;
+            int sizeX = ox == 0 ? CHUNK_SIZE_X : 1;
+            int sizeZ = oz == 0 ? CHUNK_SIZE_Z : 1;
+            snapshot.copyColumns(*neighbor, srcX, srcZ, dstX, dstZ, sizeX, sizeZ);
+
+            if (oz == 0) {
+                (ox < 0 ? snapshot.hasNegX : snapshot.hasPosX) = true;
+            } else if (ox == 0) {
+                (oz < 0 ? snapshot.hasNegZ : snapshot.hasPosZ) = true;
             }
         }
     }
 
-    return data;
+    return snapshot;
 }
 
-void Renderer::buildMeshData(Chunk& chunk, const NeighborEdgeData& neighbors) {
-    auto meshData = std::make_unique<ChunkMeshTriple>();
-    *meshData = buildChunkMeshesInternal(chunk, neighbors);
+RebuildSnapshot& Renderer::snapshotForRebuild(const Chunk& chunk) {
+    // A whole chunk, so one per thread rather than one per job
+    static thread_local auto snapshot = std::make_unique<RebuildSnapshot>();
+
+    Chunk& copy = snapshot->chunk;
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) copy.sections[s] = chunk.sections[s];
+    memcpy(copy.biomeMap, chunk.biomeMap, sizeof(chunk.biomeMap));
+    memcpy(copy.packedLight, chunk.packedLight, sizeof(chunk.packedLight));
+    copy.chunkCoords = chunk.chunkCoords;
+    snapshot->version = chunk.version;
 
-    chunk.pendingMeshData = std::move(meshData);
-    chunk.meshReady = true;
+    return *snapshot;
 }
 
 ChunkMeshTriple Renderer::buildChunkMeshesInternal(const Chunk& chunk,
-                                                   const NeighborEdgeData& neighbors) {
+                                                   const NeighborhoodSnapshot& snapshot) {
+    return buildChunkMeshesInternal(chunk, snapshot, Settings::greedyMeshing);
+}
+
+ChunkMeshTriple Renderer::buildChunkMeshesInternal(const Chunk& chunk,
+                                                   const NeighborhoodSnapshot& snapshot,
+                                                   bool greedy) {
     ChunkMeshTriple meshes;
 
     meshes.opaque.reserve(10000);
     meshes.translucent.reserve(2000);
     meshes.water.reserve(2000);
 
-    // Optimized loop order: X-Y-Z matches array memory layout for better cache performance
-    for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
+    // Translucent and water blocks, one voxel at a time; opaque blocks go through the face masks
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+        // Nothing to do in sections that are empty or hold only opaque blocks
+        if (chunk.sections[s].nonAirCount == chunk.sections[s].opaqueCount) continue;
+
+        // Y-Z-X order matches the section storage layout for better cache performance
+        for (int y = s * SECTION_SIZE; y < (s + 1) * SECTION_SIZE; y++) {
             for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                BlockIds id = static_cast<BlockIds>(chunk.blockPosition[x][y][z]);
-                if (id == ID_AIR) continue;
-
-                auto defIt = blockTextureDefs.find(id);
-                if (defIt == blockTextureDefs.end()) continue;
-
-                const BlockTextureDef& def = defIt->second;
-                unsigned char alpha = getBlockAlpha(id);
-                bool isTranslucent = isBlockTranslucent(id);
-
-                ChunkMeshBuffers* buf;
-                if (id == ID_WATER) {
-                    buf = &meshes.water;
-                } else if (isTranslucent) {
-                    buf = &meshes.translucent;
-                } else {
-                    buf = &meshes.opaque;
-                }
+                for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                    BlockIds id = static_cast<BlockIds>(snapshot.blockAt(x, y, z));
+                    if (!isBlockTranslucent(id)) continue;
+
+                    const BlockTextureDef* def = findBlockDef(id);
+                    if (!def) continue;
 
-                for (int f = 0; f < 6; f++) {
-                    if (!isFaceExposed(chunk, x, y, z, f, isTranslucent, neighbors)) continue;
+                    unsigned char alpha = getBlockAlpha(id);
+                    ChunkMeshBuffers& buf = id == ID_WATER ? meshes.water : meshes.translucent;
 
-                    // Get biome-aware tint for grass blocks
-                    int biome = chunk.biomeMap[x][z];
-                    Color faceTint = getBlockFaceTint(id, f, biome);
-                    AddFaceWithAlpha(*buf, {(float)x, (float)y, (float)z}, f, def, FACE_LIGHT[f],
-                                     faceTint, alpha, chunk, neighbors);
+                    for (int f = 0; f < 6; f++) {
+                        if (!isFaceExposed(snapshot, x, y, z, f, true)) continue;
+
+                        // Biome-aware tint for grass blocks
+                        int tint = getTintIndex(id, f, chunk.biomeMap[x][z]);
+                        int light = getFaceLightLevel(snapshot, x, y, z, f);
+                        AddFaceWithAlpha(buf, x, y, z, f, def->faceTile[f], light, tint, alpha);
+                    }
                 }
             }
         }
     }
 
+    static thread_local OpaqueFaceMasks faceMasks;
+    buildOpaqueFaceMasks(chunk, snapshot, faceMasks);
+
+    if (greedy) {
+        greedyMeshOpaque(meshes.opaque, chunk, snapshot, faceMasks);
+    } else {
+        meshOpaqueFaces(meshes.opaque, chunk, snapshot, faceMasks);
+    }
+
     return meshes;
 }
 
-void Renderer::uploadMeshToGPU(Chunk& chunk, const ChunkMeshTriple& meshData) {
-    if (chunk.opaqueModel.meshCount > 0 && IsModelValid(chunk.opaqueModel)) {
-        UnloadModel(chunk.opaqueModel);
-        chunk.opaqueModel = {0};
-    }
-    if (chunk.translucentModel.meshCount > 0 && IsModelValid(chunk.translucentModel)) {
-        UnloadModel(chunk.translucentModel);
-        chunk.translucentModel = {0};
-    }
-    if (chunk.waterModel.meshCount > 0 && IsModelValid(chunk.waterModel)) {
-        UnloadModel(chunk.waterModel);
-        chunk.waterModel = {0};
+void Renderer::buildOpaqueFaceMasks(const Chunk& chunk, const NeighborhoodSnapshot& snapshot,
+                                    OpaqueFaceMasks& masks) {
+    constexpr int WORDS = OpaqueFaceMasks::WORDS;
+    constexpr int ROW = NeighborhoodSnapshot::SIZE_X;
+
+    static const auto opaqueById = [] {
+        std::array<uint8_t, 256> opaque{};
+        for (int id = 0; id < 256; id++) opaque[id] = isBlockOpaque(id);
+        return opaque;
+    }();
+
+    // Opaque occupancy of every column in the padded 18x18 footprint, bit y = block y.
+    // Columns are numbered like a snapshot layer, so neighbours are +-1 and +-ROW away.
+    uint64_t solid[NeighborhoodSnapshot::LAYER][WORDS] = {};
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+        // No face of this chunk lies in an empty section, so neighbour bits there are never read
+        if (chunk.sections[s].isEmpty()) continue;
+
+        for (int y = s * SECTION_SIZE; y < (s + 1) * SECTION_SIZE; y++) {
+            const uint8_t* layer = &snapshot.blocks[NeighborhoodSnapshot::index(-1, y, -1)];
+            const int word = y >> 6;
+            const int bit = y & 63;
+            for (int c = 0; c < NeighborhoodSnapshot::LAYER; c++) {
+                solid[c][word] |= (uint64_t)opaqueById[layer[c]] << bit;
+            }
+        }
     }
 
-    if (!meshData.opaque.vertices.empty()) {
-        chunk.opaqueModel = createModelFromBuffers(meshData.opaque, chunk.chunkCoords);
+    for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (int x = 0; x < CHUNK_SIZE_X; x++) {
+            const int c = (z + 1) * ROW + (x + 1);
+
+            for (int w = 0; w < WORDS; w++) {
+                const uint64_t self = solid[c][w];
+                // Bit y holds the block at y + 1 / y - 1; outside the world counts as air
+                const uint64_t above = (self >> 1) | (w + 1 < WORDS ? solid[c][w + 1] << 63 : 0);
+                const uint64_t below = (self << 1) | (w > 0 ? solid[c][w - 1] >> 63 : 0);
+
+                masks.faces[0][x][z][w] = self & ~solid[c - ROW][w]; // FRONT (-Z)
+                masks.faces[1][x][z][w] = self & ~solid[c + ROW][w]; // BACK (+Z)
+                masks.faces[2][x][z][w] = self & ~solid[c - 1][w];   // LEFT (-X)
+                masks.faces[3][x][z][w] = self & ~solid[c + 1][w];   // RIGHT (+X)
+                masks.faces[4][x][z][w] = self & ~above;             // TOP (+Y)
+                masks.faces[5][x][z][w] = self & ~below;             // BOTTOM (-Y)
+            }
+        }
     }
+}
 
-    if (!meshData.translucent.vertices.empty()) {
-        chunk.translucentModel = createModelFromBuffers(meshData.translucent, chunk.chunkCoords);
-    }
+void Renderer::meshOpaqueFaces(ChunkMeshBuffers& buf, const Chunk& chunk,
+                               const NeighborhoodSnapshot& snapshot,
+                               const OpaqueFaceMasks& masks) {
+    for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+        for (int x = 0; x < CHUNK_SIZE_X; x++) {
+            const int biome = chunk.biomeMap[x][z];
+
+            for (int f = 0; f < 6; f++) {
+                for (int w = 0; w < OpaqueFaceMasks::WORDS; w++) {
+                    for (uint64_t bits = masks.faces[f][x][z][w]; bits; bits &= bits - 1) {
+                        const int y = w * 64 + std::countr_zero(bits);
 
-    if (!meshData.water.vertices.empty()) {
-        chunk.waterModel = createModelFromBuffers(meshData.water, chunk.chunkCoords);
+                        BlockIds id = static_cast<BlockIds>(snapshot.blockAt(x, y, z));
+                        const BlockTextureDef* def = findBlockDef(id);
+                        if (!def) continue;
+
+                        AddFaceWithAlpha(buf, x, y, z, f, def->faceTile[f],
+                                         getFaceLightLevel(snapshot, x, y, z, f),
+                                         getTintIndex(id, f, biome), 255);
+                    }
+                }
+            }
+        }
     }
 }
 
-bool Renderer::isFaceExposed(const Chunk& chunk, int x, int y, int z, int face, bool isTranslucent,
-                             const NeighborEdgeData& neighbors) {
-    int nx = x + dx[face];
-    int ny = y + dy[face];
-    int nz = z + dz[face];
+void Renderer::meshOpaqueFacesPerVoxel(ChunkMeshBuffers& buf, const Chunk& chunk,
+                                       const NeighborhoodSnapshot& snapshot) {
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+        if (chunk.sections[s].isEmpty()) continue;
+        if (isSectionBuried(chunk, s, snapshot)) continue;
 
-    if (ny < 0 || ny >= CHUNK_SIZE_Y) return true;
-
-    int neighborId;
-
-    if (nx < 0) {
-        if (!neighbors.hasNegX) return true; // CHANGE: Show face if no neighbor data
-        neighborId = neighbors.getBlockNegX(ny, nz);
-    } else if (nx >= CHUNK_SIZE_X) {
-        if (!neighbors.hasPosX) return true; // CHANGE: Show face if no neighbor data
-        neighborId = neighbors.getBlockPosX(ny, nz);
-    } else if (nz < 0) {
-        if (!neighbors.hasNegZ) return true; // CHANGE: Show face if no neighbor data
-        neighborId = neighbors.getBlockNegZ(nx, ny);
-    } else if (nz >= CHUNK_SIZE_Z) {
-        if (!neighbors.hasPosZ) return true; // CHANGE: Show face if no neighbor data
-        neighborId = neighbors.getBlockPosZ(nx, ny);
-    } else {
-        neighborId = chunk.blockPosition[nx][ny][nz];
-    }
+        for (int y = s * SECTION_SIZE; y < (s + 1) * SECTION_SIZE; y++) {
+            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                    BlockIds id = static_cast<BlockIds>(snapshot.blockAt(x, y, z));
+                    if (!isBlockOpaque(id)) continue;
 
-    if (neighborId == ID_AIR) return true;
+                    const BlockTextureDef* def = findBlockDef(id);
+                    if (!def) continue;
 
-    if (isTranslucent) {
-        int currentId = chunk.blockPosition[x][y][z];
-        if (neighborId == currentId) return false;
-        return true;
-    }
+                    for (int f = 0; f < 6; f++) {
+                        if (!isFaceExposed(snapshot, x, y, z, f, false)) continue;
 
-    return isBlockTranslucent(static_cast<BlockIds>(neighborId));
+                        int tint = getTintIndex(id, f, chunk.biomeMap[x][z]);
+                        int light = getFaceLightLevel(snapshot, x, y, z, f);
+                        AddFaceWithAlpha(buf, x, y, z, f, def->faceTile[f], light, tint, 255);
+                    }
+                }
+            }
+        }
+    }
 }
 
-void Renderer::AddFaceWithAlpha(ChunkMeshBuffers& buf, const Vector3& blockPos, int face,
-                                const BlockTextureDef& def, float lightLevel, Color tint,
-                                unsigned char alpha, const Chunk& chunk,
-                                const NeighborEdgeData& neighbors // ADD THIS
-) {
-    static const Vector3 FACE_VERTS[6][4] = {
-        {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}}, // Front (-Z)
-        {{1, 0, 1}, {0, 0, 1}, {0, 1, 1}, {1, 1, 1}}, // Back (+Z)
-        {{0, 0, 1}, {0, 0, 0}, {0, 1, 0}, {0, 1, 1}}, // Left (-X)
-        {{1, 0, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 0}}, // Right (+X)
-        {{0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}}, // Top (+Y)
-        {{0, 0, 1}, {1, 0, 1}, {1, 0, 0}, {0, 0, 0}}  // Bottom (-Y)
-    };
+void Renderer::greedyMeshOpaque(ChunkMeshBuffers& buf, const Chunk& chunk,
+                                const NeighborhoodSnapshot& snapshot,
+                                const OpaqueFaceMasks& masks) {
+    static const int AXIS_SIZE[3] = {CHUNK_SIZE_X, CHUNK_SIZE_Y, CHUNK_SIZE_Z};
+
+    const int topSection = chunk.getTopSection();
+    if (topSection < 0) return;
+    const int heightLimit = (topSection + 1) * SECTION_SIZE;
+
+    // Mask key: 0 = no face, otherwise (tile + 1) << 16 | tint index << 8 | light level
+    std::vector<uint32_t> mask(CHUNK_SIZE_Y * std::max(CHUNK_SIZE_X, CHUNK_SIZE_Z));
+
+    for (int f = 0; f < 6; f++) {
+        const int n = FACE_NORMAL_AXIS[f];
+        const int ua = FACE_U_AXIS[f];
+        const int va = FACE_V_AXIS[f];
+
+        const int sliceCount = n == 1 ? heightLimit : AXIS_SIZE[n];
+        const int width = ua == 1 ? heightLimit : AXIS_SIZE[ua];
+        const int height = va == 1 ? heightLimit : AXIS_SIZE[va];
+
+        // Light is uniform across a face, so equal keys shade identically
+        auto faceKey = [&](int x, int y, int z) -> uint32_t {
+            BlockIds id = static_cast<BlockIds>(snapshot.blockAt(x, y, z));
+            const BlockTextureDef* def = findBlockDef(id);
+            if (!def) return 0;
+
+            uint32_t tint = getTintIndex(id, f, chunk.biomeMap[x][z]);
+            uint32_t light = getFaceLightLevel(snapshot, x, y, z, f);
+            return ((uint32_t)(def->faceTile[f] + 1) << 16) | (tint << 8) | light;
+        };
+
+        for (int slice = 0; slice < sliceCount; slice++) {
+            std::fill_n(mask.begin(), width * height, 0);
+            bool anyFace = false;
+
+            if (n == 1) {
+                // Horizontal slice: u runs along x, v along z
+                const int word = slice >> 6;
+                const int bit = slice & 63;
+                for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+                    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                        if (!((masks.faces[f][x][z][word] >> bit) & 1)) continue;
+                        mask[z * width + x] = faceKey(x, slice, z);
+                        anyFace = true;
+                    }
+                }
+            } else {
+                // Vertical slice: u runs along the other horizontal axis, v along y
+                for (int i = 0; i < width; i++) {
+                    const int x = n == 0 ? slice : i;
+                    const int z = n == 0 ? i : slice;
+                    for (int w = 0; w < OpaqueFaceMasks::WORDS; w++) {
+                        for (uint64_t bits = masks.faces[f][x][z][w]; bits; bits &= bits - 1) {
+                            const int y = w * 64 + std::countr_zero(bits);
+                            mask[y * width + i] = faceKey(x, y, z);
+                            anyFace = true;
+                        }
+                    }
+                }
+            }
+            if (!anyFace) continue;
+
+            for (int j = 0; j < height; j++) {
+                for (int i = 0; i < width;) {
+                    uint32_t key = mask[j * width + i];
+                    if (key == 0) {
+                        i++;
+                        continue;
+                    }
 
-    static const Vector3 FACE_NORMALS[6] = {{0, 0, -1}, {0, 0, 1}, {-1, 0, 0},
-                                            {1, 0, 0},  {0, 1, 0}, {0, -1, 0}};
+                    int w = 1;
+                    while (i + w < width && mask[j * width + i + w] == key) w++;
+
+                    int h = 1;
+                    for (; j + h < height; h++) {
+                        bool rowMatches = true;
+                        for (int k = 0; k < w; k++) {
+                            if (mask[(j + h) * width + i + k] != key) {
+                                rowMatches = false;
+                                break;
+                            }
+                        }
+                        if (!rowMatches) break;
+                    }
 
-    static const Vector2 FACE_UVS[4] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+                    for (int row = 0; row < h; row++) {
+                        std::fill_n(&mask[(j + row) * width + i], w, 0);
+                    }
 
-    int idx = def.faceTile[face];
-    UVRect uv = GetAtlasUV(idx, Renderer::textureAtlas.width, Renderer::textureAtlas.height,
-                           TILE_WIDTH, TILE_HEIGHT);
+                    int origin[3];
+                    origin[n] = slice;
+                    origin[ua] = i;
+                    origin[va] = j;
 
-    int indexOffset = buf.vertices.size() / 3;
-    bool flipV = (face >= 0 && face <= 3);
+                    AddGreedyQuad(buf, origin, f, w, h, (int)(key >> 16) - 1, key & 0xF,
+                                  (key >> 8) & 0xFF);
 
-    for (int v = 0; v < 4; v++) {
-        Vector3 vert = Vector3Add(FACE_VERTS[face][v], blockPos);
-        buf.vertices.push_back(vert.x);
-        buf.vertices.push_back(vert.y);
-        buf.vertices.push_back(vert.z);
+                    i += w;
+                }
+            }
+        }
+    }
+}
 
-        buf.normals.push_back(FACE_NORMALS[face].x);
-        buf.normals.push_back(FACE_NORMALS[face].y);
-        buf.normals.push_back(FACE_NORMALS[face].z);
+void Renderer::AddGreedyQuad(ChunkMeshBuffers& buf, const int origin[3], int face, int width,
+                             int height, int tile, int light, int tint) {
+    int scale[3] = {1, 1, 1};
+    scale[FACE_U_AXIS[face]] = width;
+    scale[FACE_V_AXIS[face]] = height;
 
-        float u = uv.u0 + (uv.u1 - uv.u0) * FACE_UVS[v].x;
-        float tv = uv.v0 + (uv.v1 - uv.v0) * (flipV ? 1.0f - FACE_UVS[v].y : FACE_UVS[v].y);
-        buf.texcoords.push_back(u);
-        buf.texcoords.push_back(tv);
+    // Texcoords come from the position in the shader, so the texture repeats once per block
+    for (int v = 0; v < 4; v++) {
+        const Vector3& corner = FACE_VERTS[face][v];
+        buf.vertices.push_back(packChunkVertex(origin[0] + (int)corner.x * scale[0],
+                                               origin[1] + (int)corner.y * scale[1],
+                                               origin[2] + (int)corner.z * scale[2], face, light,
+                                               tile, tint, 255));
+    }
+}
 
-        float vertexLight = getVertexLight(chunk, (int)blockPos.x, (int)blockPos.y, (int)blockPos.z,
-                                           face, v, neighbors);
+bool Renderer::isSectionBuried(const Chunk& chunk, int section,
+                               const NeighborhoodSnapshot& snapshot) {
+    if (!chunk.sections[section].isAllOpaque()) return false;
 
-        float combinedLight = vertexLight * FACE_LIGHT[face];
+    // Faces on the top and bottom of the world are always emitted
+    if (section == 0 || !chunk.sections[section - 1].isAllOpaque()) return false;
+    if (section == CHUNK_SECTION_COUNT - 1 || !chunk.sections[section + 1].isAllOpaque())
+        return false;
 
-        unsigned char r = (unsigned char)(tint.r * combinedLight);
-        unsigned char g = (unsigned char)(tint.g * combinedLight);
-        unsigned char b = (unsigned char)(tint.b * combinedLight);
+    if (!snapshot.hasNegX || !snapshot.hasPosX || !snapshot.hasNegZ || !snapshot.hasPosZ)
+        return false;
 
-        buf.colors.push_back(r);
-        buf.colors.push_back(g);
-        buf.colors.push_back(b);
-        buf.colors.push_back(alpha);
+    for (int y = section * SECTION_SIZE; y < (section + 1) * SECTION_SIZE; y++) {
+        for (int i = 0; i < CHUNK_SIZE_X; i++) {
+            if (!isBlockOpaque(snapshot.blockAt(-1, y, i))) return false;
+            if (!isBlockOpaque(snapshot.blockAt(CHUNK_SIZE_X, y, i))) return false;
+            if (!isBlockOpaque(snapshot.blockAt(i, y, -1))) return false;
+            if (!isBlockOpaque(snapshot.blockAt(i, y, CHUNK_SIZE_Z))) return false;
+        }
     }
 
-    buf.indices.push_back(indexOffset + 0);
-    buf.indices.push_back(indexOffset + 2);
-    buf.indices.push_back(indexOffset + 1);
-    buf.indices.push_back(indexOffset + 0);
-    buf.indices.push_back(indexOffset + 3);
-    buf.indices.push_back(indexOffset + 2);
+    return true;
 }
 
-ChunkMeshTriple Renderer::buildChunkMeshes(const Chunk& chunk) {
-    ChunkMeshTriple meshes;
+// The arena copies straight out of the worker-built vectors, so each one is freed as soon as it
+// is on the GPU rather than when the whole triple goes
+static ChunkGpuMesh uploadAndRelease(ChunkMeshBuffers& buf) {
+    ChunkGpuMesh mesh = Renderer::createMeshFromBuffers(buf);
+    std::vector<PackedVertex>().swap(buf.vertices);
+    return mesh;
+}
 
-    NeighborEdgeData neighbors = cacheNeighborEdges(chunk.chunkCoords);
+bool Renderer::isFaceExposed(const NeighborhoodSnapshot& snapshot, int x, int y, int z, int face,
+                             bool isTranslucent) {
+    const int i = NeighborhoodSnapshot::index(x, y, z);
+    int neighborId = snapshot.blocks[i + NeighborhoodSnapshot::FACE_OFFSET[face]];
 
-    // Optimized loop order: X-Y-Z matches array memory layout for better cache performance
-    for (int x = 0; x < CHUNK_SIZE_X; x++) {
-        for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-            for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-                BlockIds id = static_cast<BlockIds>(chunk.blockPosition[x][y][z]);
-                if (id == ID_AIR) continue;
-
-                auto defIt = blockTextureDefs.find(id);
-                if (defIt == blockTextureDefs.end()) continue;
-
-                const BlockTextureDef& def = defIt->second;
-                unsigned char alpha = getBlockAlpha(id);
-                bool isTranslucent = isBlockTranslucent(id);
-
-                ChunkMeshBuffers* buf;
-                if (id == ID_WATER) {
-                    buf = &meshes.water;
-                } else if (isTranslucent) {
-                    buf = &meshes.translucent;
-                } else {
-                    buf = &meshes.opaque;
-                }
+    if (neighborId == ID_AIR) return true;
 
-                for (int f = 0; f < 6; f++) {
-                    if (!isFaceExposed(chunk, x, y, z, f, isTranslucent, neighbors)) continue;
+    if (isTranslucent) {
+        return neighborId != snapshot.blocks[i];
+    }
 
-                    // Get biome-aware tint for grass blocks
-                    int biome = chunk.biomeMap[x][z];
-                    Color faceTint = getBlockFaceTint(id, f, biome);
-                    AddFaceWithAlpha(*buf, {(float)x, (float)y, (float)z}, f, def, FACE_LIGHT[f],
-                                     faceTint, alpha, chunk, neighbors);
-                }
-            }
-        }
+    return isBlockTranslucent(static_cast<BlockIds>(neighborId));
+}
+
+void Renderer::AddFaceWithAlpha(ChunkMeshBuffers& buf, int x, int y, int z, int face, int tile,
+                                int light, int tint, unsigned char alpha) {
+    for (int v = 0; v < 4; v++) {
+        const Vector3& corner = FACE_VERTS[face][v];
+        buf.vertices.push_back(packChunkVertex(x + (int)corner.x, y + (int)corner.y,
+                                               z + (int)corner.z, face, light, tile, tint, alpha));
     }
+}
 
-    return meshes;
+ChunkMeshTriple Renderer::buildChunkMeshes(const Chunk& chunk) {
+    return buildChunkMeshesInternal(chunk, snapshotNeighborhood(chunk));
 }
 
 void Renderer::buildChunkModel(const Chunk& chunk) {
@@ -314,101 +490,98 @@ void Renderer::buildChunkModel(const Chunk& chunk) {
 
 #ifndef NDEBUG
     std::println("Chunk ({}, {}) - opaque: {}, translucent: {}, water: {}", chunk.chunkCoords.x,
-                 chunk.chunkCoords.z, meshes.opaque.vertices.size() / 3,
-                 meshes.translucent.vertices.size() / 3, meshes.water.vertices.size() / 3);
+                 chunk.chunkCoords.z, meshes.opaque.vertices.size(),
+                 meshes.translucent.vertices.size(), meshes.water.vertices.size());
 #endif
 
-    if (chunk.opaqueModel.meshCount > 0 && IsModelValid(chunk.opaqueModel)) {
-        UnloadModel(chunk.opaqueModel);
-    }
-    if (!meshes.opaque.vertices.empty()) {
-        chunk.opaqueModel = buildModelFromBuffers(meshes.opaque);
-    } else {
-        chunk.opaqueModel = {0};
-    }
-
-    if (chunk.translucentModel.meshCount > 0 && IsModelValid(chunk.translucentModel)) {
-        UnloadModel(chunk.translucentModel);
-    }
-    if (!meshes.translucent.vertices.empty()) {
-        chunk.translucentModel = buildModelFromBuffers(meshes.translucent);
-    } else {
-        chunk.translucentModel = {0};
-    }
-
-    if (chunk.waterModel.meshCount > 0 && IsModelValid(chunk.waterModel)) {
-        UnloadModel(chunk.waterModel);
-    }
-    if (!meshes.water.vertices.empty()) {
-        chunk.waterModel = buildModelFromBuffers(meshes.water);
-#ifndef NDEBUG
-        std::println("Water model built with {} meshes", chunk.waterModel.meshCount);
-#endif
-    } else {
-        chunk.waterModel = {0};
-#ifndef NDEBUG
-        std::println("No water vertices - model not built");
-#endif
-    }
+    unloadChunkMeshes(chunk);
+    chunk.opaqueMesh = uploadAndRelease(meshes.opaque);
+    chunk.translucentMesh = uploadAndRelease(meshes.translucent);
+    chunk.waterMesh = uploadAndRelease(meshes.water);
 }
 
-void Renderer::drawChunkTranslucent(const std::unique_ptr<Chunk>& chunk, const Camera3D& camera) {
+void Renderer::drawChunkTranslucent(const Chunk* chunk, const Camera3D& camera) {
     if (!isBoxInCachedFrustum(chunk->boundingBox)) return;
     if (!chunk->loaded) return;
-    if (chunk->translucentModel.meshCount == 0) return;
+    if (!chunk->translucentMesh.isValid()) return;
 
     Vector3 worldPos = {(float)(chunk->chunkCoords.x * CHUNK_SIZE_X), 0.0f,
                         (float)(chunk->chunkCoords.z * CHUNK_SIZE_Z)};
 
-    DrawModel(chunk->translucentModel, worldPos, 1.0f, WHITE);
+    drawChunkMesh(chunk->translucentMesh, chunkShader, worldPos, WHITE);
 }
 
-void Renderer::drawChunkWater(const std::unique_ptr<Chunk>& chunk, const Camera3D& camera) {
+void Renderer::drawChunkWater(const Chunk* chunk, const Camera3D& camera) {
     if (!isBoxInCachedFrustum(chunk->boundingBox)) return;
     if (!chunk->loaded) return;
-    if (chunk->waterModel.meshCount == 0) return;
+    if (!chunk->waterMesh.isValid()) return;
 
     Vector3 worldPos = {(float)(chunk->chunkCoords.x * CHUNK_SIZE_X), 0.0f,
                         (float)(chunk->chunkCoords.z * CHUNK_SIZE_Z)};
 
-    chunk->waterModel.materials[0].shader = waterShader;
-
-    DrawModel(chunk->waterModel, worldPos, 1.0f, WHITE);
+    drawChunkMesh(chunk->waterMesh, waterShader, worldPos, WHITE);
 }
 
-Model Renderer::buildModelFromBuffers(ChunkMeshBuffers& buf) {
-    if (buf.vertices.empty()) {
-        return {0};
-    }
+ChunkMeshArena Renderer::meshArena;
 
-    Mesh mesh = {0};
-    mesh.vertexCount = buf.vertices.size() / 3;
-    mesh.triangleCount = buf.indices.size() / 3;
+// GL state bound between beginChunkDraws and endChunkDraws, so consecutive chunks that share a
+// shader or arena page skip rebinding it
+static struct {
+    unsigned int shaderId = 0;
+    int page = -1;
+    Matrix viewProjection;
+} chunkDrawState;
 
-    mesh.vertices = (float*)MemAlloc(buf.vertices.size() * sizeof(float));
-    memcpy(mesh.vertices, buf.vertices.data(), buf.vertices.size() * sizeof(float));
+void Renderer::beginChunkDraws() {
+    // Anything raylib has batched must reach the GPU before we bind our own state
+    rlDrawRenderBatchActive();
 
-    mesh.normals = (float*)MemAlloc(buf.normals.size() * sizeof(float));
-    memcpy(mesh.normals, buf.normals.data(), buf.normals.size() * sizeof(float));
+    // Chunks differ only by a translation, which the shader adds, so one matrix serves all
+    chunkDrawState.viewProjection = MatrixMultiply(
+        MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()), rlGetMatrixProjection());
+    chunkDrawState.shaderId = 0;
+    chunkDrawState.page = -1;
 
-    mesh.texcoords = (float*)MemAlloc(buf.texcoords.size() * sizeof(float));
-    memcpy(mesh.texcoords, buf.texcoords.data(), buf.texcoords.size() * sizeof(float));
+    rlActiveTextureSlot(0);
+    rlEnableTexture(textureAtlas.id);
+}
 
-    mesh.colors = (unsigned char*)MemAlloc(buf.colors.size());
-    memcpy(mesh.colors, buf.colors.data(), buf.colors.size());
+void Renderer::endChunkDraws() {
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+    chunkDrawState.shaderId = 0;
+    chunkDrawState.page = -1;
+}
+
+void Renderer::drawChunkMesh(const ChunkGpuMesh& mesh, const Shader& shader, Vector3 position,
+                             Color tint) {
+    if (!mesh.isValid()) return;
+
+    if (chunkDrawState.shaderId != shader.id) {
+        rlEnableShader(shader.id);
+        rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], chunkDrawState.viewProjection);
+
+        int textureSlot = 0;
+        rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &textureSlot, SHADER_UNIFORM_INT, 1);
+        chunkDrawState.shaderId = shader.id;
+    }
 
-    mesh.indices = (unsigned short*)MemAlloc(buf.indices.size() * sizeof(unsigned short));
-    memcpy(mesh.indices, buf.indices.data(), buf.indices.size() * sizeof(unsigned short));
+    if (chunkDrawState.page != mesh.page) {
+        meshArena.bindPage(mesh.page);
+        chunkDrawState.page = mesh.page;
+    }
 
-    UploadMesh(&mesh, true);
+    int offsetLoc = shader.id == waterShader.id ? waterOffsetLoc : chunkOffsetLoc;
+    rlSetUniform(offsetLoc, &position, SHADER_UNIFORM_VEC3, 1);
 
-    Model model = LoadModelFromMesh(mesh);
-    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = textureAtlas;
+    float diffuse[4] = {tint.r / 255.0f, tint.g / 255.0f, tint.b / 255.0f, tint.a / 255.0f};
+    rlSetUniform(shader.locs[SHADER_LOC_COLOR_DIFFUSE], diffuse, SHADER_UNIFORM_VEC4, 1);
 
-    return model;
+    meshArena.draw(mesh);
 }
 
-void Renderer::drawChunkOpaque(const std::unique_ptr<Chunk>& chunk, const Camera3D& camera) {
+void Renderer::drawChunkOpaque(Chunk* chunk, const Camera3D& camera) {
     if (!isBoxInCachedFrustum(chunk->boundingBox)) return;
     if (!chunk->loaded) return;
 
@@ -421,26 +594,36 @@ void Renderer::drawChunkOpaque(const std::unique_ptr<Chunk>& chunk, const Camera
     Color tint = WHITE;
     tint.a = (unsigned char)(chunk->alpha * 255);
 
-    if (chunk->opaqueModel.meshCount > 0) {
-        DrawModel(chunk->opaqueModel, worldPos, 1.0f, tint);
-    }
+    drawChunkMesh(chunk->opaqueMesh, chunkShader, worldPos, tint);
 }
 
 void Renderer::drawAllChunks(const Camera3D& camera) {
     // Update frustum planes once per frame
     updateFrustumPlanes(camera);
 
-    for (auto& [coord, chunk] : ChunkHelper::activeChunks) {
-        if (chunk) {
-            drawChunkOpaque(chunk, camera);
-        }
+    beginChunkDraws();
+
+    // Opaque draws don't depend on order, so group them by arena page to cut VAO switches
+    std::vector<Chunk*> opaqueChunks;
+    opaqueChunks.reserve(ChunkHelper::activeChunks.size());
+    for (Chunk* chunk : ChunkHelper::activeChunks) {
+        opaqueChunks.push_back(chunk);
+    }
+
+    std::sort(opaqueChunks.begin(), opaqueChunks.end(), [](const Chunk* a, const Chunk* b) {
+        return a->opaqueMesh.page < b->opaqueMesh.page;
+    });
+
+    for (Chunk* chunk : opaqueChunks) {
+        drawChunkOpaque(chunk, camera);
     }
 
     std::vector<std::pair<float, ChunkCoord>> translucentChunks;
     std::vector<std::pair<float, ChunkCoord>> waterChunks;
 
-    for (auto& [coord, chunk] : ChunkHelper::activeChunks) {
-        if (chunk && chunk->translucentModel.meshCount > 0 || chunk->waterModel.meshCount > 0) {
+    for (const Chunk* chunk : ChunkHelper::activeChunks) {
+        if (chunk->translucentMesh.isValid() || chunk->waterMesh.isValid()) {
+            const ChunkCoord coord = chunk->chunkCoords;
             Vector3 chunkCenter = {(float)(coord.x * CHUNK_SIZE_X + CHUNK_SIZE_X / 2),
                                    CHUNK_SIZE_Y / 2.0f,
                                    (float)(coord.z * CHUNK_SIZE_Z + CHUNK_SIZE_Z / 2)};
@@ -457,17 +640,18 @@ void Renderer::drawAllChunks(const Camera3D& camera) {
     rlSetBlendMode(BLEND_ALPHA);
 
     for (auto& [dist, coord] : translucentChunks) {
-        auto it = ChunkHelper::activeChunks.find(coord);
-        if (it != ChunkHelper::activeChunks.end() && it->second) {
-            if (it->second->translucentModel.meshCount > 0) {
-                drawChunkTranslucent(it->second, camera);
+        if (const Chunk* chunk = ChunkHelper::activeChunks.find(coord)) {
+            if (chunk->translucentMesh.isValid()) {
+                drawChunkTranslucent(chunk, camera);
             }
-            if (it->second->waterModel.meshCount > 0) {
-                drawChunkWater(it->second, camera);
+            if (chunk->waterMesh.isValid()) {
+                drawChunkWater(chunk, camera);
             }
         }
     }
 
+    endChunkDraws();
+
     rlEnableDepthMask();
     rlSetBlendMode(BLEND_ALPHA);
 }
@@ -489,8 +673,8 @@ bool Renderer::isFaceExposed(const Chunk& chunk, int x, int y, int z, int face)
         nz >= CHUNK_SIZE_Z)
         return true;
 
-    int currentId = chunk.blockPosition[x][y][z];
-    int neighborId = chunk.blockPosition[nx][ny][nz];
+    int currentId = chunk.getBlock(x, y, z);
+    int neighborId = chunk.getBlock(nx, ny, nz);
 
     if (neighborId == ID_AIR) return true;
 
@@ -612,9 +796,69 @@ bool Renderer::isBoxInCachedFrustum(const BoundingBox& box) {
     return IsBoxInFrustum(box, cachedFrustumPlanes);
 }
 
+ChunkCoord Renderer::lastRequestChunk{INT_MIN, INT_MIN};
+Vector2 Renderer::lastRequestForward{0.0f, 0.0f};
+std::atomic<int> Renderer::requestCenterX = 0;
+std::atomic<int> Renderer::requestCenterZ = 0;
+std::atomic<int> Renderer::skippedChunkJobs = 0;
+std::atomic<int> Renderer::wastedChunkJobs = 0;
+std::atomic<int> Renderer::staleRebuilds = 0;
+
+bool Renderer::isRequestStale(const ChunkCoord& coord, const ChunkCoord& center) {
+    return abs(coord.x - center.x) > Settings::preLoadDistance ||
+           abs(coord.z - center.z) > Settings::preLoadDistance;
+}
+
+void Renderer::finishChunkRequest(const ChunkCoord& coord) {
+    std::lock_guard<std::mutex> lock(ChunkHelper::chunkRequestSetMutex);
+    ChunkHelper::chunkRequestSet.erase(coord);
+}
+
+float Renderer::chunkRequestPriority(const ChunkCoord& coord, const ChunkCoord& playerChunk,
+                                     Vector2 forward) {
+    float dx = (float)(coord.x - playerChunk.x);
+    float dz = (float)(coord.z - playerChunk.z);
+    float dist = sqrtf(dx * dx + dz * dz);
+
+    // The ring under the player comes first whichever way they face
+    if (dist < 1.5f) return dist;
+
+    // Straight ahead counts as half the distance, straight behind as double
+    float facing = (dx * forward.x + dz * forward.y) / dist;
+    return dist * (1.25f - 0.75f * facing);
+}
+
 void Renderer::checkActiveChunks(const Camera3D& camera) {
     ChunkCoord playerChunk = getPlayerChunkCoord(camera);
 
+    // Looking straight up or down leaves no horizontal facing, so keep scoring by the last one
+    // rather than treating every such frame as a turn
+    Vector2 forward = {camera.target.x - camera.position.x, camera.target.z - camera.position.z};
+    const bool hasFacing = Vector2LengthSqr(forward) > 1e-6f;
+    forward = hasFacing ? Vector2Normalize(forward) : lastRequestForward;
+
+    // Queued requests were scored from where the player was; re-score after a chunk crossing
+    // or a turn of more than 45 degrees
+    if (!(playerChunk == lastRequestChunk)) {
+        requestCenterX = playerChunk.x;
+        requestCenterZ = playerChunk.z;
+
+        // Requests left behind by the move are dropped before a worker ever sees them
+        std::vector<ChunkCoord> stale = ChunkHelper::chunkRequestQueue.removeIf(
+            [&](const ChunkCoord& coord) { return isRequestStale(coord, playerChunk); });
+        for (const ChunkCoord& coord : stale) finishChunkRequest(coord);
+        skippedChunkJobs += (int)stale.size();
+    }
+
+    if (!(playerChunk == lastRequestChunk) ||
+        (hasFacing && Vector2DotProduct(forward, lastRequestForward) < 0.7071f)) {
+        ChunkHelper::chunkRequestQueue.reprioritize([&](const ChunkCoord& coord) {
+            return chunkRequestPriority(coord, playerChunk, forward);
+        });
+        lastRequestChunk = playerChunk;
+        lastRequestForward = forward;
+    }
+
     std::vector<ChunkCoord> coordsToRequest;
 
     {
@@ -634,76 +878,105 @@ void Renderer::checkActiveChunks(const Camera3D& camera) {
         }
     }
 
-    if (!coordsToRequest.empty()) {
-        std::lock_guard<std::mutex> lock(ChunkHelper::chunkRequestQueueMtx);
-        for (const auto& coord : coordsToRequest) {
-            ChunkHelper::chunkRequestQueue.push(coord);
-        }
+    for (const auto& coord : coordsToRequest) {
+        ChunkHelper::chunkRequestQueue.push(coord,
+                                            chunkRequestPriority(coord, playerChunk, forward));
+        submitChunkGeneration();
     }
 }
 
 #include <cassert>
 
+std::vector<ChunkGpuMesh> Renderer::meshFreeQueue;
+std::vector<std::unique_ptr<Chunk>> Renderer::retiredChunks;
+size_t Renderer::residentChunkBytes = 0;
+int Renderer::unloadedChunkCount = 0;
+
 void Renderer::unloadChunks(const Camera3D& camera) {
-    ChunkCoord playerChunk{worldToChunk(camera.position.x, CHUNK_SIZE_X),
-                           worldToChunk(camera.position.z, CHUNK_SIZE_Z)};
+    ChunkCoord playerChunk = getPlayerChunkCoord(camera);
 
-    std::vector<ChunkCoord> toRemove;
+    // Never unload inside the preload square, or it would be requested straight back
+    const int unloadDistance = std::max(Settings::unloadDistance, Settings::preLoadDistance + 1);
+    const size_t budget = (size_t)Settings::chunkMemoryBudgetMB * 1024 * 1024;
 
-    for (const auto& [coord, chunk] : ChunkHelper::activeChunks) {
-        int dx = coord.x - playerChunk.x;
-        int dz = coord.z - playerChunk.z;
+    {
+        std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
 
-        if (abs(dx) > Settings::unloadDistance || abs(dz) > Settings::unloadDistance) {
-            if (chunk && chunk->loaded) {
-                toRemove.push_back(coord);
-            }
-        }
-    }
+        std::vector<std::pair<int, ChunkCoord>> candidates;
+        size_t resident = 0;
 
-    for (const auto& coord : toRemove) {
-        auto it = ChunkHelper::activeChunks.find(coord);
-        if (it == ChunkHelper::activeChunks.end()) continue;
+        for (const Chunk* chunk : ChunkHelper::activeChunks) {
+            resident += chunk->memoryUsage();
 
-        // Unload both models
-        if (it->second->opaqueModel.meshCount > 0 && IsModelValid(it->second->opaqueModel)) {
-            UnloadModel(it->second->opaqueModel);
-        }
-        if (it->second->translucentModel.meshCount > 0 &&
-            IsModelValid(it->second->translucentModel)) {
-            UnloadModel(it->second->translucentModel);
+            const ChunkCoord coord = chunk->chunkCoords;
+            int ring = std::max(abs(coord.x - playerChunk.x), abs(coord.z - playerChunk.z));
+            if (ring > Settings::preLoadDistance) candidates.push_back({ring, coord});
         }
-        if (it->second->waterModel.meshCount > 0 && IsModelValid(it->second->waterModel)) {
-            UnloadModel(it->second->waterModel);
+
+        // Farthest first: everything past the unload ring, then more only while over budget
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        for (const auto& [ring, coord] : candidates) {
+            if (ring <= unloadDistance && resident <= budget) break;
+
+            std::unique_ptr<Chunk> chunk = ChunkHelper::activeChunks.remove(coord);
+            resident -= chunk->memoryUsage();
+            retireChunk(std::move(chunk));
+            unloadedChunkCount++;
         }
 
-        it->second->loaded = false;
-        ChunkHelper::activeChunks.erase(it);
+        residentChunkBytes = resident;
     }
-}
 
-void Renderer::shutdown() {
-    ChunkHelper::workerRunning = false;
-    ChunkHelper::chunkRequestQueue.notifyAll();
+    // Spread the frees out so a burst of unloads doesn't land in one frame
+    for (int i = 0; i < UNLOAD_FREES_PER_FRAME && !meshFreeQueue.empty(); i++) {
+        meshArena.release(meshFreeQueue.back());
+        meshFreeQueue.pop_back();
+    }
 
-    for (auto& t : Renderer::workers) {
-        if (t.joinable()) t.join();
+    for (int i = 0; i < UNLOAD_FREES_PER_FRAME && !retiredChunks.empty(); i++) {
+        retiredChunks.pop_back();
     }
-    Renderer::workers.clear();
+}
 
-    std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
-    for (auto& [coord, chunk] : ChunkHelper::activeChunks) {
-        if (!chunk) continue;
+void Renderer::retireChunk(std::unique_ptr<Chunk> chunk) {
+    chunksAwaitingNeighbors.erase(chunk->chunkCoords);
 
-        if (chunk->opaqueModel.meshCount > 0 && IsModelValid(chunk->opaqueModel)) {
-            UnloadModel(chunk->opaqueModel);
-        }
-        if (chunk->translucentModel.meshCount > 0 && IsModelValid(chunk->translucentModel)) {
-            UnloadModel(chunk->translucentModel);
+    for (ChunkGpuMesh* mesh : {&chunk->opaqueMesh, &chunk->translucentMesh, &chunk->waterMesh}) {
+        if (mesh->isValid()) meshFreeQueue.push_back(*mesh);
+        *mesh = {};
+    }
+
+    std::erase_if(pendingUploads, [&](const ChunkUpload& upload) {
+        if (upload.chunk != chunk.get()) return false;
+        for (const ChunkGpuMesh& mesh : upload.meshes) {
+            if (mesh.isValid()) meshFreeQueue.push_back(mesh);
         }
+        return true;
+    });
+
+    chunk->loaded = false;
+    retiredChunks.push_back(std::move(chunk));
+}
+
+void Renderer::shutdown() {
+    shutdownJobSystem();
+
+    std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+    for (Chunk* chunk : ChunkHelper::activeChunks) {
+        unloadChunkMeshes(*chunk);
     }
     ChunkHelper::activeChunks.clear();
 
+    pendingUploads.clear();
+    meshFreeQueue.clear();
+    retiredChunks.clear();
+    ChunkCoord discarded;
+    while (readyMeshes.try_pop(discarded)) {
+    }
+    meshArena.unload();
+
     if (textureAtlas.id > 0 && IsTextureValid(textureAtlas)) {
         UnloadTexture(textureAtlas);
         textureAtlas.id = 0;
@@ -747,25 +1020,9 @@ UVRect Renderer::GetAtlasUV(int tileIndex, int atlasWidth, int atlasHeight, int
 void Renderer::replaceChunk(const ChunkCoord& coord, std::unique_ptr<Chunk> newChunk) {
     std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
 
-    try {
-        auto it = ChunkHelper::activeChunks.find(coord);
-        if (it != ChunkHelper::activeChunks.end() && it->second) {
-            if (it->second->opaqueModel.meshCount > 0 && IsModelValid(it->second->opaqueModel)) {
-                UnloadModel(it->second->opaqueModel);
-            }
-            if (it->second->translucentModel.meshCount > 0 &&
-                IsModelValid(it->second->translucentModel)) {
-                UnloadModel(it->second->translucentModel);
-            }
-            if (it->second->waterModel.meshCount > 0 && IsModelValid(it->second->waterModel)) {
-                UnloadModel(it->second->waterModel);
-            }
-        }
-    } catch (...) {
-        std::cerr << "Map access crashed!" << std::endl;
-    }
-
-    ChunkHelper::activeChunks[coord] = std::move(newChunk);
+    // Lock-free readers may still hold the old chunk, so it's retired rather than freed here
+    std::unique_ptr<Chunk> previous = ChunkHelper::activeChunks.insert(coord, std::move(newChunk));
+    if (previous) retireChunk(std::move(previous));
 }
 
 void Renderer::drawCrosshair() {
@@ -782,29 +1039,118 @@ void Renderer::drawCrosshair() {
 
 Shader Renderer::waterShader = {0};
 int Renderer::waterTimeLoc = 0;
+int Renderer::waterOffsetLoc = -1;
 
-void Renderer::initWaterShader() {
-    const char* vsCode = R"(
-        #version 330
-        in vec3 vertexPosition;
-        in vec2 vertexTexCoord;
-        in vec4 vertexColor;
-        out vec2 fragTexCoord;
-        out vec4 fragColor;
-        uniform mat4 mvp;
-        void main() {
-            fragTexCoord = vertexTexCoord;
-            fragColor = vertexColor;
-            gl_Position = mvp * vec4(vertexPosition, 1.0);
+std::vector<Color> Renderer::tintPalette;
+uint8_t Renderer::tintIndices[BLOCK_ID_COUNT][6][BIOME_COUNT] = {};
+
+void Renderer::initTintPalette() {
+    tintPalette.clear();
+    tintPalette.push_back(WHITE);
+
+    for (int id = 0; id < BLOCK_ID_COUNT; id++) {
+        for (int face = 0; face < 6; face++) {
+            for (int biome = 0; biome < BIOME_COUNT; biome++) {
+                Color tint = getBlockFaceTint(static_cast<BlockIds>(id), face, biome);
+
+                size_t index = 0;
+                while (index < tintPalette.size() &&
+                       (tintPalette[index].r != tint.r || tintPalette[index].g != tint.g ||
+                        tintPalette[index].b != tint.b)) {
+                    index++;
+                }
+
+                if (index == tintPalette.size()) {
+                    if (tintPalette.size() >= MAX_TINT_PALETTE) {
+#ifndef NDEBUG
+                        std::println("Tint palette full, block {} face {} falls back to white", id,
+                                     face);
+#endif
+                        index = 0;
+                    } else {
+                        tintPalette.push_back(tint);
+                    }
+                }
+
+                tintIndices[id][face][biome] = (uint8_t)index;
+            }
         }
-    )";
+    }
+}
+
+// Shared by the chunk and water shaders; unpacks the PackedVertex layout from Chunk.hpp
+static const char* CHUNK_VERTEX_SHADER = R"(
+    #version 330
+    layout(location = 0) in vec4 vertexData;
+    out vec3 fragLocalPos;
+    flat out int fragFace;
+    flat out int fragTile;
+    out vec4 fragColor;
+    uniform mat4 mvp;
+    uniform vec3 chunkOffset;
+    uniform vec3 tintPalette[64];
+    uniform float faceLight[6];
+    void main() {
+        uvec4 d = uvec4(vertexData);
+        vec3 pos = vec3(float(d.y & 31u), float(d.x & 511u), float((d.y >> 5u) & 31u));
+        int face = int((d.x >> 9u) & 7u);
+        float light = float(d.x >> 12u);
+
+        float shade = (0.15 + 0.85 * light / 15.0) * faceLight[face];
+        fragColor = vec4(tintPalette[d.w & 255u] * shade, float(d.w >> 8u) / 255.0);
+        fragLocalPos = pos;
+        fragFace = face;
+        fragTile = int(d.z);
+        gl_Position = mvp * vec4(pos + chunkOffset, 1.0);
+    }
+)";
+
+// Fragment shader head shared by the chunk and water shaders. Texcoords come from the
+// position within the face, so they repeat once per block across greedy quads
+static const char* CHUNK_FRAGMENT_COMMON = R"(
+    #version 330
+    in vec3 fragLocalPos;
+    flat in int fragFace;
+    flat in int fragTile;
+    in vec4 fragColor;
+    out vec4 finalColor;
+    uniform sampler2D texture0;
+    uniform vec4 colDiffuse;
+    uniform float tileSize;
+
+    vec2 atlasUV() {
+        vec3 p = fragLocalPos;
+        vec2 uv;
+        if (fragFace == 0) uv = vec2(p.x, -p.y);
+        else if (fragFace == 1) uv = vec2(-p.x, -p.y);
+        else if (fragFace == 2) uv = vec2(-p.z, -p.y);
+        else if (fragFace == 3) uv = vec2(p.z, -p.y);
+        else if (fragFace == 4) uv = vec2(p.x, p.z);
+        else uv = vec2(p.x, -p.z);
+
+        // The atlas is a single column, so u always spans the full width
+        vec2 local = fract(uv);
+        return vec2(local.x, (float(fragTile) + local.y) * tileSize);
+    }
+)";
+
+static void setChunkShaderUniforms(Shader shader) {
+    std::vector<Vector3> palette;
+    for (const Color& c : Renderer::tintPalette) {
+        palette.push_back({c.r / 255.0f, c.g / 255.0f, c.b / 255.0f});
+    }
+    SetShaderValueV(shader, GetShaderLocation(shader, "tintPalette"), palette.data(),
+                    SHADER_UNIFORM_VEC3, (int)palette.size());
+    SetShaderValueV(shader, GetShaderLocation(shader, "faceLight"), FACE_LIGHT,
+                    SHADER_UNIFORM_FLOAT, 6);
+
+    float tileSize = TILE_HEIGHT / (float)Renderer::textureAtlas.height;
+    SetShaderValue(shader, GetShaderLocation(shader, "tileSize"), &tileSize,
+                   SHADER_UNIFORM_FLOAT);
+}
 
-    const char* fsCode = R"(
-        #version 330
-        in vec2 fragTexCoord;
-        in vec4 fragColor;
-        out vec4 finalColor;
-        uniform sampler2D texture0;
+void Renderer::initWaterShader() {
+    std::string fsCode = std::string(CHUNK_FRAGMENT_COMMON) + R"(
         uniform float waterTime;
 
         void main() {
@@ -813,7 +1159,7 @@ void Renderer::initWaterShader() {
 
             int frame = int(mod(waterTime * 10.0, float(frameCount)));
 
-            vec2 animUV = fragTexCoord;
+            vec2 animUV = atlasUV();
             animUV.y += float(frame) * tileHeight;
 
             vec4 texColor = texture(texture0, animUV);
@@ -823,272 +1169,358 @@ void Renderer::initWaterShader() {
         }
     )";
 
-    waterShader = LoadShaderFromMemory(vsCode, fsCode);
+    waterShader = LoadShaderFromMemory(CHUNK_VERTEX_SHADER, fsCode.c_str());
     waterTimeLoc = GetShaderLocation(waterShader, "waterTime");
+    waterOffsetLoc = GetShaderLocation(waterShader, "chunkOffset");
+    setChunkShaderUniforms(waterShader);
+}
+
+Shader Renderer::chunkShader = {0};
+int Renderer::chunkOffsetLoc = -1;
+
+void Renderer::initChunkShader() {
+    std::string fsCode = std::string(CHUNK_FRAGMENT_COMMON) + R"(
+        void main() {
+            finalColor = texture(texture0, atlasUV()) * colDiffuse * fragColor;
+        }
+    )";
+
+    chunkShader = LoadShaderFromMemory(CHUNK_VERTEX_SHADER, fsCode.c_str());
+    chunkOffsetLoc = GetShaderLocation(chunkShader, "chunkOffset");
+    setChunkShaderUniforms(chunkShader);
 }
 
 void Renderer::updateWaterShader(float time) {
     SetShaderValue(waterShader, waterTimeLoc, &time, SHADER_UNIFORM_FLOAT);
 }
 
-float Renderer::getVertexLight(const Chunk& chunk, int bx, int by, int bz, int face, int vertex,
-                               const NeighborEdgeData& neighbors) {
-    static const int fdx[6] = {0, 0, -1, 1, 0, 0};
-    static const int fdy[6] = {0, 0, 0, 0, 1, -1};
-    static const int fdz[6] = {-1, 1, 0, 0, 0, 0};
-
-    int lx = bx + fdx[face];
-    int ly = by + fdy[face];
-    int lz = bz + fdz[face];
-
-    if (ly < 0) return 0.15f;
-    if (ly >= CHUNK_SIZE_Y) return 1.0f;
-
-    int lightLevel;
-    bool usedNeighbor = false;
-
-    if (lx < 0) {
-        usedNeighbor = true;
-        lightLevel = neighbors.hasNegX ? neighbors.getLightNegX(ly, lz) : 15;
-    } else if (lx >= CHUNK_SIZE_X) {
-        usedNeighbor = true;
-        lightLevel = neighbors.hasPosX ? neighbors.getLightPosX(ly, lz) : 15;
-    } else if (lz < 0) {
-        usedNeighbor = true;
-        lightLevel = neighbors.hasNegZ ? neighbors.getLightNegZ(lx, ly) : 15;
-    } else if (lz >= CHUNK_SIZE_Z) {
-        usedNeighbor = true;
-        lightLevel = neighbors.hasPosZ ? neighbors.getLightPosZ(lx, ly) : 15;
-    } else {
-        lightLevel = chunk.getLightLevel(lx, ly, lz);
-    }
+int Renderer::getFaceLightLevel(const NeighborhoodSnapshot& snapshot, int bx, int by, int bz,
+                                int face) {
+    return snapshot.light[NeighborhoodSnapshot::index(bx, by, bz) +
+                          NeighborhoodSnapshot::FACE_OFFSET[face]];
+}
 
-#ifndef NDEBUG
-    static int debugCount = 0;
-    if (usedNeighbor && debugCount++ < 50) {
-        printf("DEBUG getVertexLight: block(%d,%d,%d) face=%d sample(%d,%d,%d) light=%d "
-               "hasNeighbor=%s\n",
-               bx, by, bz, face, lx, ly, lz, lightLevel,
-               (lx < 0               ? (neighbors.hasNegX ? "YES" : "NO")
-                : lx >= CHUNK_SIZE_X ? (neighbors.hasPosX ? "YES" : "NO")
-                : lz < 0             ? (neighbors.hasNegZ ? "YES" : "NO")
-                                     : (neighbors.hasPosZ ? "YES" : "NO")));
-#endif
-    }
+void Renderer::initJobSystem(int threadCount) {
+    ChunkHelper::workerRunning = true;
+    jobs = std::make_unique<JobSystem>(threadCount);
+}
 
-    float minLight = 0.15f;
-    return minLight + 0.85f * (lightLevel / 15.0f);
+void Renderer::shutdownJobSystem() {
+    ChunkHelper::workerRunning = false;
+    if (jobs) {
+        jobs->shutdown();
+        jobs.reset();
+    }
 }
 
-void Renderer::initMeshThreadPool(int threads) {
-    g_meshThreadPool = std::make_unique<MeshThreadPool>(threads);
+ChunkGpuMesh Renderer::createMeshFromBuffers(const ChunkMeshBuffers& buf) {
+    return meshArena.upload(buf);
 }
 
-void Renderer::shutdownMeshThreadPool() {
-    if (g_meshThreadPool) {
-        g_meshThreadPool->shutdown();
-        g_meshThreadPool.reset();
-    }
+void Renderer::unloadChunkMesh(ChunkGpuMesh& mesh) { meshArena.release(mesh); }
+
+void Renderer::unloadChunkMeshes(const Chunk& chunk) {
+    unloadChunkMesh(chunk.opaqueMesh);
+    unloadChunkMesh(chunk.translucentMesh);
+    unloadChunkMesh(chunk.waterMesh);
 }
 
-void Renderer::buildChunkMeshAsync(Chunk& chunk) {
-    if (chunk.meshBuilding.exchange(true)) return;
+void Renderer::submitChunkGeneration() {
+    // Generation fills it in, lighting passes it on
+    auto generated = std::make_shared<std::unique_ptr<Chunk>>();
+
+    JobSystem::JobHandle generate = jobs->submit(
+        [generated]() {
+            // Whichever request is most urgent by now, not the one that caused this submit
+            ChunkCoord coord;
+            if (!ChunkHelper::workerRunning) return;
+            if (!ChunkHelper::chunkRequestQueue.try_pop(coord)) return;
+
+            // The player may have moved on since this was queued
+            if (isRequestStale(coord, {requestCenterX.load(), requestCenterZ.load()})) {
+                skippedChunkJobs++;
+                finishChunkRequest(coord);
+                return;
+            }
 
-    NeighborEdgeData neighbors = cacheNeighborEdges(chunk.chunkCoords);
+            *generated = ChunkHelper::generateChunkAsync({(float)coord.x, 0.0f, (float)coord.z});
+        },
+        JobPriority::LOW);
 
-#ifndef NDEBUG
-    printf("DEBUG: Building mesh for (%d,%d) - neighbors: -X=%d +X=%d -Z=%d +Z=%d\n",
-           chunk.chunkCoords.x, chunk.chunkCoords.z, neighbors.hasNegX, neighbors.hasPosX,
-           neighbors.hasNegZ, neighbors.hasPosZ);
-#endif
+    jobs->submit(
+        [generated]() {
+            if (!*generated) return;
+            Chunk& chunk = **generated;
 
-    auto meshData = std::make_unique<ChunkMeshTriple>();
-    *meshData = buildChunkMeshesInternal(chunk, neighbors);
+            // Check again before lighting, the other half of the cost
+            if (isRequestStale(chunk.chunkCoords, {requestCenterX.load(), requestCenterZ.load()})) {
+                wastedChunkJobs++;
+                finishChunkRequest(chunk.chunkCoords);
+                return;
+            }
 
-    chunk.pendingMeshData = std::move(meshData);
-    chunk.meshBuilding = false;
-    chunk.meshReady = true;
+            LightingSystem::calculateSkyLight(chunk);
+            LightingSystem::calculateBlockLight(chunk);
+
+            // Only full if the main thread has stalled for thousands of chunks; wait it out
+            while (!ChunkHelper::chunkBuildQueue.try_push(std::move(*generated))) {
+                std::this_thread::yield();
+            }
+        },
+        JobPriority::NORMAL, {generate});
 }
 
-void Renderer::uploadMeshToGPU(Chunk& chunk) {
-    if (!chunk.pendingMeshData) return;
+void Renderer::processChunkBuildQueue(const Camera3D& camera) {
+    constexpr int MAX_CHUNKS_PER_FRAME = 2;
+    int processed = 0;
 
-    // Unload old models
-    if (chunk.opaqueModel.meshCount > 0 && IsModelValid(chunk.opaqueModel)) {
-        UnloadModel(chunk.opaqueModel);
-        chunk.opaqueModel = {0};
-    }
-    if (chunk.translucentModel.meshCount > 0 && IsModelValid(chunk.translucentModel)) {
-        UnloadModel(chunk.translucentModel);
-        chunk.translucentModel = {0};
-    }
-    if (chunk.waterModel.meshCount > 0 && IsModelValid(chunk.waterModel)) {
-        UnloadModel(chunk.waterModel);
-        chunk.waterModel = {0};
-    }
+    ChunkCoord playerChunk = getPlayerChunkCoord(camera);
 
-    const ChunkMeshTriple& meshData = *chunk.pendingMeshData;
+    // Pop only what this frame will use; the rest stays queued rather than being pushed back
+    std::unique_ptr<Chunk> chunk;
+    while (processed < MAX_CHUNKS_PER_FRAME && ChunkHelper::chunkBuildQueue.try_pop(chunk)) {
+        if (!chunk) continue;
 
-    if (!meshData.opaque.vertices.empty()) {
-        chunk.opaqueModel = createModelFromBuffers(meshData.opaque, chunk.chunkCoords);
-    }
+        ChunkCoord coord = chunk->chunkCoords;
 
-    if (!meshData.translucent.vertices.empty()) {
-        chunk.translucentModel = createModelFromBuffers(meshData.translucent, chunk.chunkCoords);
-    }
+        // Finished after the player left its area; don't spend a slot on it
+        if (isRequestStale(coord, playerChunk)) {
+            wastedChunkJobs++;
+            finishChunkRequest(coord);
+            continue;
+        }
 
-    if (!meshData.water.vertices.empty()) {
-        chunk.waterModel = createModelFromBuffers(meshData.water, chunk.chunkCoords);
-    }
+        finishChunkRequest(coord);
 
-    chunk.pendingMeshData.reset();
-    chunk.meshReady = false;
-    chunk.loaded = true;
-}
+        chunk->loaded = false;
+        chunk->dirty = false;
+        chunk->meshReady = false;
+        chunk->meshBuilding = false;
 
-Model Renderer::createModelFromBuffers(const ChunkMeshBuffers& buf, const ChunkCoord& coord) {
-    Mesh mesh = {0};
+        replaceChunk(coord, std::move(chunk));
 
-    mesh.vertexCount = buf.vertices.size() / 3;
-    mesh.triangleCount = buf.indices.size() / 3;
+        uint16_t relit;
+        {
+            std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+            relit = LightingSystem::connectChunk(coord);
+        }
+
+        // Neighbours still waiting may now be complete. One that was already meshed (the outer
+        // ring as the player moves) was built with this side open, or lit without this chunk,
+        // and needs a rebuild.
+        for (int i = 0; i < LightNeighborhood::COUNT; i++) {
+            if (i == LightNeighborhood::CENTER) continue;
 
-    mesh.vertices = (float*)MemAlloc(buf.vertices.size() * sizeof(float));
-    memcpy(mesh.vertices, buf.vertices.data(), buf.vertices.size() * sizeof(float));
+            int ox = LightNeighborhood::offsetX(i);
+            int oz = LightNeighborhood::offsetZ(i);
+            bool sharesEdge = ox == 0 || oz == 0;
+            if (!sharesEdge && !(relit & (1 << i))) continue;
 
-    mesh.normals = (float*)MemAlloc(buf.normals.size() * sizeof(float));
-    memcpy(mesh.normals, buf.normals.data(), buf.normals.size() * sizeof(float));
+            ChunkCoord n{coord.x + ox, coord.z + oz};
+            if (!chunksAwaitingNeighbors.contains(n)) ChunkHelper::markChunkDirty(n);
+        }
+        chunksAwaitingNeighbors.insert(coord);
 
-    mesh.texcoords = (float*)MemAlloc(buf.texcoords.size() * sizeof(float));
-    memcpy(mesh.texcoords, buf.texcoords.data(), buf.texcoords.size() * sizeof(float));
+        processed++;
+    }
 
-    mesh.colors = (unsigned char*)MemAlloc(buf.colors.size() * sizeof(unsigned char));
-    memcpy(mesh.colors, buf.colors.data(), buf.colors.size() * sizeof(unsigned char));
+    queueChunksWithNeighbors(camera);
+}
 
-    mesh.indices = (unsigned short*)MemAlloc(buf.indices.size() * sizeof(unsigned short));
-    memcpy(mesh.indices, buf.indices.data(), buf.indices.size() * sizeof(unsigned short));
+std::unordered_set<ChunkCoord, ChunkCoordHash> Renderer::chunksAwaitingNeighbors;
 
-    UploadMesh(&mesh, false);
+bool Renderer::isReadyToMesh(const ChunkCoord& coord, const ChunkCoord& playerChunk) {
+    for (int i = 0; i < 4; i++) {
+        ChunkCoord n{coord.x + NEIGHBOR_DX[i], coord.z + NEIGHBOR_DZ[i]};
 
-    Model model = LoadModelFromMesh(mesh);
-    model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = textureAtlas;
+        // Nothing is loaded beyond the outer ring, so don't wait on those sides
+        int ring = std::max(abs(n.x - playerChunk.x), abs(n.z - playerChunk.z));
+        if (ring > Settings::preLoadDistance) continue;
 
-    return model;
+        if (!ChunkHelper::activeChunks.contains(n)) return false;
+    }
+    return true;
 }
 
-void Renderer::initChunkWorkers(int threadCount) {
-    ChunkHelper::workerRunning = true;
-    for (int i = 0; i < threadCount; i++) {
-        Renderer::workers.emplace_back([]() {
-            while (ChunkHelper::workerRunning) {
-                ChunkCoord coord;
-                try {
-                    coord = ChunkHelper::chunkRequestQueue.wait_pop(ChunkHelper::workerRunning);
-                } catch (...) {
-                    continue;
-                }
-                if (!ChunkHelper::workerRunning) break;
+void Renderer::queueChunksWithNeighbors(const Camera3D& camera) {
+    if (chunksAwaitingNeighbors.empty()) return;
 
-                auto chunk =
-                    ChunkHelper::generateChunkAsync({(float)coord.x, 0.0f, (float)coord.z});
+    ChunkCoord playerChunk = getPlayerChunkCoord(camera);
 
-                LightingSystem::calculateSkyLight(*chunk);
-                LightingSystem::calculateBlockLight(*chunk);
+    std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+    for (auto it = chunksAwaitingNeighbors.begin(); it != chunksAwaitingNeighbors.end();) {
+        const ChunkCoord coord = *it;
 
-                ChunkHelper::chunkBuildQueue.push(std::move(chunk));
-            }
-        });
+        Chunk* chunk = ChunkHelper::activeChunks.find(coord);
+        if (!chunk) {
+            it = chunksAwaitingNeighbors.erase(it);
+            continue;
+        }
+        if (!isReadyToMesh(coord, playerChunk)) {
+            ++it;
+            continue;
+        }
+
+        // Already building means a mesh is on its way; otherwise mesh it from a snapshot like an
+        // edit rebuild, so no worker reads the live chunk unlocked
+        if (!chunk->meshBuilding.load()) submitChunkMesh(*chunk, JobPriority::NORMAL);
+
+        it = chunksAwaitingNeighbors.erase(it);
     }
 }
 
-void Renderer::processChunkBuildQueue(const Camera3D& camera) {
-    constexpr int MAX_CHUNKS_PER_FRAME = 2;
-    int processed = 0;
+MpscQueue<ChunkCoord> Renderer::readyMeshes{8192};
+std::vector<Renderer::ChunkUpload> Renderer::pendingUploads;
+int Renderer::droppedMeshStreams = 0;
+int Renderer::compactionRemeshes = 0;
 
-    std::vector<std::unique_ptr<Chunk>> pendingChunks;
-    {
-        std::unique_ptr<Chunk> chunk;
-        while (ChunkHelper::chunkBuildQueue.try_pop(chunk)) {
-            if (chunk) {
-                pendingChunks.push_back(std::move(chunk));
+void Renderer::queueMeshUpload(const Chunk& chunk) {
+    while (!readyMeshes.try_push(chunk.chunkCoords)) {
+        std::this_thread::yield();
+    }
+}
+
+void Renderer::uploadPendingMeshes(const Camera3D& camera) {
+    std::vector<ChunkCoord> ready;
+    readyMeshes.pop_batch(std::back_inserter(ready), readyMeshes.capacity());
+
+    std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+
+    for (const ChunkCoord& coord : ready) {
+        Chunk* found = ChunkHelper::activeChunks.find(coord);
+        if (!found) continue;
+
+        Chunk& chunk = *found;
+        if (!chunk.meshReady.load() || !chunk.pendingMeshData) continue;
+
+        // A newer mesh replaces one still being written for the same chunk
+        for (auto u = pendingUploads.begin(); u != pendingUploads.end(); ++u) {
+            if (u->coord == coord) {
+                for (ChunkGpuMesh& mesh : u->meshes) meshArena.release(mesh);
+                pendingUploads.erase(u);
+                break;
             }
         }
+
+        ChunkUpload upload;
+        upload.coord = coord;
+        upload.chunk = &chunk;
+        upload.data = std::move(chunk.pendingMeshData);
+        chunk.meshReady = false;
+        pendingUploads.push_back(std::move(upload));
     }
 
-    for (auto& chunk : pendingChunks) {
-        if (processed >= MAX_CHUNKS_PER_FRAME) {
-            ChunkHelper::chunkBuildQueue.push(std::move(chunk));
-            continue;
-        }
+    if (pendingUploads.empty()) return;
 
-        ChunkCoord coord = chunk->chunkCoords;
+    auto distanceSqr = [&camera](const ChunkCoord& c) {
+        float dx = c.x * CHUNK_SIZE_X + CHUNK_SIZE_X / 2 - camera.position.x;
+        float dz = c.z * CHUNK_SIZE_Z + CHUNK_SIZE_Z / 2 - camera.position.z;
+        return dx * dx + dz * dz;
+    };
 
-        {
-            std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
-            auto& activeChunks = ChunkHelper::activeChunks;
-            if (activeChunks.count({coord.x - 1, coord.z})) {
-                LightingSystem::spreadLightFromNeighbor(*chunk,
-                                                        *activeChunks[{coord.x - 1, coord.z}], 0);
-            }
-            if (activeChunks.count({coord.x + 1, coord.z})) {
-                LightingSystem::spreadLightFromNeighbor(*chunk,
-                                                        *activeChunks[{coord.x + 1, coord.z}], 1);
-            }
-            if (activeChunks.count({coord.x, coord.z - 1})) {
-                LightingSystem::spreadLightFromNeighbor(*chunk,
-                                                        *activeChunks[{coord.x, coord.z - 1}], 2);
-            }
-            if (activeChunks.count({coord.x, coord.z + 1})) {
-                LightingSystem::spreadLightFromNeighbor(*chunk,
-                                                        *activeChunks[{coord.x, coord.z + 1}], 3);
+    // Nearest first, but finish anything already partly written so it stops holding arena space
+    std::sort(pendingUploads.begin(), pendingUploads.end(),
+              [&](const ChunkUpload& a, const ChunkUpload& b) {
+                  if (a.started() != b.started()) return a.started();
+                  return distanceSqr(a.coord) < distanceSqr(b.coord);
+              });
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bytesLeft = UPLOAD_BYTES_PER_FRAME;
+    size_t finished = 0;
+
+    while (finished < pendingUploads.size() && bytesLeft > 0) {
+        if (!advanceUpload(pendingUploads[finished], bytesLeft)) break;
+
+        finishUpload(pendingUploads[finished]);
+        finished++;
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= UPLOAD_MS_PER_FRAME) break;
+    }
+
+    pendingUploads.erase(pendingUploads.begin(), pendingUploads.begin() + finished);
+}
+
+bool Renderer::advanceUpload(ChunkUpload& upload, size_t& bytesLeft) {
+    ChunkMeshBuffers* streams[3] = {&upload.data->opaque, &upload.data->translucent,
+                                    &upload.data->water};
+
+    while (upload.stream < 3) {
+        std::vector<PackedVertex>& vertices = streams[upload.stream]->vertices;
+        ChunkGpuMesh& mesh = upload.meshes[upload.stream];
+
+        if (upload.streamOffset == 0 && !mesh.isValid()) {
+            mesh = meshArena.allocate((int)vertices.size());
+
+            // Empty, or too big for a page
+            if (!mesh.isValid()) {
+                if (!vertices.empty()) droppedMeshStreams++;
+                upload.stream++;
+                continue;
             }
         }
 
-        chunk->loaded = false;
-        chunk->dirty = false;
-        chunk->meshReady = false;
-        chunk->meshBuilding = false;
+        int count = std::min<int>(mesh.vertexCount - upload.streamOffset,
+                                  (int)(bytesLeft / sizeof(PackedVertex)));
+        if (count == 0) return false;
 
-        replaceChunk(coord, std::move(chunk));
+        meshArena.write(mesh, upload.streamOffset, vertices.data() + upload.streamOffset, count);
+        upload.streamOffset += count;
+        bytesLeft -= count * sizeof(PackedVertex);
 
-        g_meshThreadPool->submit([coord]() {
-            // Get chunk pointer under lock, then release before building
-            // This reduces mutex contention significantly
-            Chunk* chunkPtr = nullptr;
-            {
-                std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
-                auto it = ChunkHelper::activeChunks.find(coord);
-                if (it != ChunkHelper::activeChunks.end() && it->second) {
-                    chunkPtr = it->second.get();
-                }
-            }
-            if (chunkPtr) {
-                Renderer::buildChunkMeshAsync(*chunkPtr);
-            }
-        });
+        if (upload.streamOffset < mesh.vertexCount) return false;
 
-        ChunkHelper::markChunkDirty(coord);
-        ChunkHelper::markChunkDirty({coord.x - 1, coord.z});
-        ChunkHelper::markChunkDirty({coord.x + 1, coord.z});
-        ChunkHelper::markChunkDirty({coord.x, coord.z - 1});
-        ChunkHelper::markChunkDirty({coord.x, coord.z + 1});
+        // On the GPU now, so the CPU copy can go
+        std::vector<PackedVertex>().swap(vertices);
+        upload.stream++;
+        upload.streamOffset = 0;
+    }
 
-        processed++;
+    return true;
+}
+
+void Renderer::finishUpload(ChunkUpload& upload) {
+    // Gone, or replaced by a fresh copy the mesh wasn't built from
+    Chunk* found = ChunkHelper::activeChunks.find(upload.coord);
+    if (found != upload.chunk) {
+        for (ChunkGpuMesh& mesh : upload.meshes) meshArena.release(mesh);
+        return;
     }
+
+    Chunk& chunk = *found;
+    unloadChunkMeshes(chunk);
+    chunk.opaqueMesh = upload.meshes[0];
+    chunk.translucentMesh = upload.meshes[1];
+    chunk.waterMesh = upload.meshes[2];
+    chunk.loaded = true;
 }
 
-void Renderer::uploadPendingMeshes() {
+void Renderer::compactMeshArena() {
+    const int page = meshArena.drainingPage(COMPACT_PAGE_FILL);
+    if (page < 0) return;
+
     std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
 
-    int uploaded = 0;
-    constexpr int MAX_UPLOADS_PER_FRAME = 4;
+    int submitted = 0;
+    for (Chunk* chunk : ChunkHelper::activeChunks) {
+        if (submitted >= COMPACT_REMESHES_PER_FRAME) break;
 
-    for (auto& [coord, chunk] : ChunkHelper::activeChunks) {
-        if (!chunk) continue;
-        if (!chunk->meshReady.load()) continue;
-        if (uploaded >= MAX_UPLOADS_PER_FRAME) break;
+        if (chunk->opaqueMesh.page != page && chunk->translucentMesh.page != page &&
+            chunk->waterMesh.page != page) {
+            continue;
+        }
 
-        uploadMeshToGPU(*chunk);
-        uploaded++;
+        // Already has a new mesh on the way, which will land outside the page
+        if (chunk->meshBuilding.load() || chunk->meshReady.load()) continue;
+        if (std::ranges::any_of(pendingUploads,
+                                [&](const ChunkUpload& upload) { return upload.chunk == chunk; })) {
+            continue;
+        }
+
+        submitChunkMesh(*chunk, JobPriority::LOW);
+        compactionRemeshes++;
+        submitted++;
     }
 }
 
@@ -1098,41 +1530,56 @@ void Renderer::rebuildDirtyChunks() {
     int submitted = 0;
     constexpr int MAX_SUBMITS_PER_FRAME = 1; // Only 1!
 
-    for (auto& [coord, chunk] : ChunkHelper::activeChunks) {
-        if (!chunk || !chunk->dirty) continue;
+    for (Chunk* chunk : ChunkHelper::activeChunks) {
+        if (!chunk->dirty) continue;
         if (chunk->meshBuilding.load()) continue;
         if (submitted >= MAX_SUBMITS_PER_FRAME) break;
 
         chunk->dirty = false;
+        submitChunkMesh(*chunk, JobPriority::HIGH);
 
-        ChunkCoord c = coord;
-        g_meshThreadPool->submit([c]() {
-            std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
-            auto it = ChunkHelper::activeChunks.find(c);
-            if (it == ChunkHelper::activeChunks.end() || !it->second) return;
+        submitted++;
+    }
+}
 
-            Chunk& chunk = *it->second;
+void Renderer::submitChunkMesh(Chunk& chunk, JobPriority priority) {
+    chunk.meshBuilding = true;
 
-            LightingSystem::calculateSkyLight(chunk);
-            LightingSystem::calculateBlockLight(chunk);
+    const ChunkCoord coord = chunk.chunkCoords;
+    jobs->submit([coord]() { Renderer::buildChunkMesh(coord); }, priority);
+}
 
-            auto& activeChunks = ChunkHelper::activeChunks;
-            if (activeChunks.count({c.x - 1, c.z})) {
-                LightingSystem::spreadLightFromNeighbor(chunk, *activeChunks[{c.x - 1, c.z}], 0);
-            }
-            if (activeChunks.count({c.x + 1, c.z})) {
-                LightingSystem::spreadLightFromNeighbor(chunk, *activeChunks[{c.x + 1, c.z}], 1);
-            }
-            if (activeChunks.count({c.x, c.z - 1})) {
-                LightingSystem::spreadLightFromNeighbor(chunk, *activeChunks[{c.x, c.z - 1}], 2);
-            }
-            if (activeChunks.count({c.x, c.z + 1})) {
-                LightingSystem::spreadLightFromNeighbor(chunk, *activeChunks[{c.x, c.z + 1}], 3);
-            }
+void Renderer::buildChunkMesh(const ChunkCoord& coord) {
+    RebuildSnapshot* rebuild = nullptr;
+    NeighborhoodSnapshot* neighborhood = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+        const Chunk* live = ChunkHelper::activeChunks.find(coord);
+        if (!live) return;
 
-            Renderer::buildChunkMeshAsync(chunk);
-        });
+        rebuild = &snapshotForRebuild(*live);
+        neighborhood = &snapshotNeighborhood(*live);
+    }
 
-        submitted++;
+    // Light is kept current by the edits themselves, so this only remeshes
+    Chunk& chunk = rebuild->chunk;
+    auto meshData =
+        std::make_unique<ChunkMeshTriple>(buildChunkMeshesInternal(chunk, *neighborhood));
+    meshBuildCount++;
+
+    std::lock_guard<std::mutex> lock(ChunkHelper::activeChunksMutex);
+    Chunk* found = ChunkHelper::activeChunks.find(coord);
+    if (!found) return;
+
+    Chunk& live = *found;
+    live.meshBuilding = false;
+    if (live.version != rebuild->version) {
+        // Edited since the snapshot; it's dirty again, so a fresh rebuild will follow
+        staleRebuilds++;
+        return;
     }
+
+    live.pendingMeshData = std::move(meshData);
+    live.meshReady = true;
+    queueMeshUpload(live);
 }
\ No newline at end of file
@@ -6,12 +6,16 @@
 #define REFACTOREDCLONE_RENDERER_HPP
 
 #pragma once
+#include <mutex>
 #include <raylib.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "../../include/Block/Blocks.hpp"
 #include "Chunk/Chunk.hpp"
+#include "ChunkMeshArena.hpp"
+#include "../MultiThreading/JobSystem.hpp"
 #include "../../include/Common.hpp"
 
 struct UVRect {
@@ -41,6 +45,10 @@ static const int dx[6] = {  0,  0, -1,  1,  0,  0 };
 static const int dy[6] = {  0,  0,  0,  0,  1, -1 };
 static const int dz[6] = { -1,  1,  0,  0,  0,  0 };
 
+// The four horizontal neighbours: -X, +X, -Z, +Z
+static const int NEIGHBOR_DX[4] = { -1,  1,  0,  0 };
+static const int NEIGHBOR_DZ[4] = {  0,  0, -1,  1 };
+
 // In Renderer.hpp - add these declarations
 
 struct FaceTemplate {
@@ -69,55 +77,59 @@ static const FaceTemplate FACE_TEMPLATES[6] = {
     {{{0,0,1},{0,0,0},{1,0,0},{1,0,1}}, {0,-1,0}}
 };
 
-struct NeighborEdgeData {
-    std::unique_ptr<uint8_t[]> blocksNegX;
-    std::unique_ptr<uint8_t[]> blocksPosX;
-    std::unique_ptr<uint8_t[]> blocksNegZ;
-    std::unique_ptr<uint8_t[]> blocksPosZ;
+// Blocks and light of one chunk plus a one-block border from all eight neighbours
+// (diagonals included) and one layer below and above the world. The mesher reads any
+// adjacent cell with a constant offset instead of branching on chunk edges.
+// Missing neighbours and the layer above the world read as air at light 15; the layer
+// below the world reads as air at light 0.
+struct NeighborhoodSnapshot {
+    static constexpr int SIZE_X = CHUNK_SIZE_X + 2;
+    static constexpr int SIZE_Y = CHUNK_SIZE_Y + 2;
+    static constexpr int SIZE_Z = CHUNK_SIZE_Z + 2;
+    static constexpr int LAYER = SIZE_X * SIZE_Z;
+    static constexpr int VOLUME = LAYER * SIZE_Y;
+
+    // Index step to the adjacent cell, in face order
+    static constexpr int FACE_OFFSET[6] = {-SIZE_X, SIZE_X, -1, 1, LAYER, -LAYER};
+
+    // y-major like the section storage; chunk-local coordinates, -1 and CHUNK_SIZE are the border
+    static constexpr int index(int x, int y, int z) {
+        return ((y + 1) * SIZE_Z + (z + 1)) * SIZE_X + (x + 1);
+    }
 
-    std::unique_ptr<uint8_t[]> lightNegX;
-    std::unique_ptr<uint8_t[]> lightPosX;
-    std::unique_ptr<uint8_t[]> lightNegZ;
-    std::unique_ptr<uint8_t[]> lightPosZ;
+    std::unique_ptr<uint8_t[]> blocks = std::make_unique<uint8_t[]>(VOLUME);
+    // max(sky, block) light like Chunk::getLightLevel
+    std::unique_ptr<uint8_t[]> light = std::make_unique<uint8_t[]>(VOLUME);
 
     bool hasNegX = false;
     bool hasPosX = false;
     bool hasNegZ = false;
     bool hasPosZ = false;
 
-    NeighborEdgeData() {
-        blocksNegX = std::make_unique<uint8_t[]>(CHUNK_SIZE_Y * CHUNK_SIZE_Z);
-        blocksPosX = std::make_unique<uint8_t[]>(CHUNK_SIZE_Y * CHUNK_SIZE_Z);
-        blocksNegZ = std::make_unique<uint8_t[]>(CHUNK_SIZE_X * CHUNK_SIZE_Y);
-        blocksPosZ = std::make_unique<uint8_t[]>(CHUNK_SIZE_X * CHUNK_SIZE_Y);
+    uint8_t blockAt(int x, int y, int z) const { return blocks[index(x, y, z)]; }
+    uint8_t lightAt(int x, int y, int z) const { return light[index(x, y, z)]; }
 
-        lightNegX = std::make_unique<uint8_t[]>(CHUNK_SIZE_Y * CHUNK_SIZE_Z);
-        lightPosX = std::make_unique<uint8_t[]>(CHUNK_SIZE_Y * CHUNK_SIZE_Z);
-        lightNegZ = std::make_unique<uint8_t[]>(CHUNK_SIZE_X * CHUNK_SIZE_Y);
-        lightPosZ = std::make_unique<uint8_t[]>(CHUNK_SIZE_X * CHUNK_SIZE_Y);
-    }
+    // Reset to the no-neighbour state
+    void clear();
+
+    // Copy a sizeX by sizeZ column region of src, starting at (srcX, srcZ), to (dstX, dstZ)
+    void copyColumns(const Chunk& src, int srcX, int srcZ, int dstX, int dstZ, int sizeX, int sizeZ);
+};
+
+// The chunk a rebuild meshes, copied under activeChunksMutex so the remesh can run without it
+struct RebuildSnapshot {
+    Chunk chunk;
+    uint64_t version = 0;
+};
 
-    // Helper accessors
-    inline uint8_t getBlockNegX(int y, int z) const { return blocksNegX[y * CHUNK_SIZE_Z + z]; }
-    inline uint8_t getBlockPosX(int y, int z) const { return blocksPosX[y * CHUNK_SIZE_Z + z]; }
-    inline uint8_t getBlockNegZ(int x, int y) const { return blocksNegZ[x * CHUNK_SIZE_Y + y]; }
-    inline uint8_t getBlockPosZ(int x, int y) const { return blocksPosZ[x * CHUNK_SIZE_Y + y]; }
-
-    inline uint8_t getLightNegX(int y, int z) const { return lightNegX[y * CHUNK_SIZE_Z + z]; }
-    inline uint8_t getLightPosX(int y, int z) const { return lightPosX[y * CHUNK_SIZE_Z + z]; }
-    inline uint8_t getLightNegZ(int x, int y) const { return lightNegZ[x * CHUNK_SIZE_Y + y]; }
-    inline uint8_t getLightPosZ(int x, int y) const { return lightPosZ[x * CHUNK_SIZE_Y + y]; }
-
-    inline void setBlockNegX(int y, int z, uint8_t v) { blocksNegX[y * CHUNK_SIZE_Z + z] = v; }
-    inline void setBlockPosX(int y, int z, uint8_t v) { blocksPosX[y * CHUNK_SIZE_Z + z] = v; }
-    inline void setBlockNegZ(int x, int y, uint8_t v) { blocksNegZ[x * CHUNK_SIZE_Y + y] = v; }
-    inline void setBlockPosZ(int x, int y, uint8_t v) { blocksPosZ[x * CHUNK_SIZE_Y + y] = v; }
-
-    inline void setLightNegX(int y, int z, uint8_t v) { lightNegX[y * CHUNK_SIZE_Z + z] = v; }
-    inline void setLightPosX(int y, int z, uint8_t v) { lightPosX[y * CHUNK_SIZE_Z + z] = v; }
-    inline void setLightNegZ(int x, int y, uint8_t v) { lightNegZ[x * CHUNK_SIZE_Y + y] = v; }
-    inline void setLightPosZ(int x, int y, uint8_t v) { lightPosZ[x * CHUNK_SIZE_Y + y] = v; }
+// Exposed faces of the chunk's opaque blocks, one bit per y in each (x, z) column
+struct OpaqueFaceMasks {
+    static constexpr int WORDS = CHUNK_SIZE_Y / 64;
+
+    // [face][x][z][y / 64], bit y % 64
+    uint64_t faces[6][CHUNK_SIZE_X][CHUNK_SIZE_Z][WORDS];
 };
+
 inline float FACE_LIGHT[6] = {0.9f, 0.9f, 0.8f, 0.8f, 1.0f, 0.6f};
 class Renderer {
 public:
@@ -131,21 +143,100 @@ public:
     };
 
 
-    static NeighborEdgeData cacheNeighborEdges(const ChunkCoord& coord);
+    // Fill this thread's reusable snapshot from chunk and its loaded neighbours.
+    // The reference stays valid until the same thread takes another snapshot.
+    static NeighborhoodSnapshot &snapshotNeighborhood(const Chunk &chunk);
+
+    // Copy chunk into this thread's reusable rebuild snapshot; caller holds activeChunksMutex
+    static RebuildSnapshot &snapshotForRebuild(const Chunk &chunk);
+
+    // A finished mesh on its way to the GPU. The chunk keeps drawing its current meshes while
+    // these fill, possibly over several frames, and they swap in together once complete.
+    struct ChunkUpload {
+        ChunkCoord coord;
+        const Chunk* chunk = nullptr; // Built for this one; a chunk reloaded at coord is another
+        std::unique_ptr<ChunkMeshTriple> data;
+        ChunkGpuMesh meshes[3]; // Opaque, translucent, water
+        int stream = 0;         // Index into meshes being written
+        int streamOffset = 0;   // Vertices of that stream already on the GPU
+
+        bool started() const { return stream > 0 || streamOffset > 0 || meshes[stream].isValid(); }
+    };
+
+    // Chunks whose mesh workers have finished, waiting for the main thread to pick them up
+    static MpscQueue<ChunkCoord> readyMeshes;
+
+    // Uploads in flight, main thread only
+    static std::vector<ChunkUpload> pendingUploads;
+
+    static constexpr size_t UPLOAD_BYTES_PER_FRAME = 1024 * 1024;
+    static constexpr double UPLOAD_MS_PER_FRAME = 2.0;
+
+    // Mesh streams too big for an arena page, which their chunk draws without. Main thread only,
+    // for debug output.
+    static int droppedMeshStreams;
+
+    // Remesh a few chunks out of the arena page being drained, if any, so it empties and is freed.
+    // Their new meshes come through the upload queue like any other.
+    static void compactMeshArena();
+
+    // Pages at most this full are drained
+    static constexpr float COMPACT_PAGE_FILL = 0.25f;
+    static constexpr int COMPACT_REMESHES_PER_FRAME = 4;
+
+    // Chunks remeshed to drain arena pages, main thread only
+    static int compactionRemeshes;
+
+    // Hand a chunk's pendingMeshData to the upload queue. Called by mesh workers.
+    static void queueMeshUpload(const Chunk &chunk);
+
+    // Write finished meshes nearest the camera first until this frame's byte or time budget
+    // runs out. A mesh that doesn't fit carries over and is only swapped in once complete.
+    static void uploadPendingMeshes(const Camera3D &camera);
+
+    // Write as much of upload as bytesLeft allows; true once every stream is on the GPU
+    static bool advanceUpload(ChunkUpload &upload, size_t &bytesLeft);
+
+    // Swap a completed upload into its chunk, or free it if the chunk has gone
+    static void finishUpload(ChunkUpload &upload);
+
+     static ChunkMeshTriple buildChunkMeshesInternal(const Chunk &chunk, const NeighborhoodSnapshot &snapshot);
+
+     // greedy selects greedyMeshOpaque for the opaque pass instead of one quad per face
+     static ChunkMeshTriple buildChunkMeshesInternal(const Chunk &chunk, const NeighborhoodSnapshot &snapshot, bool greedy);
+
+    // Cull opaque faces a column at a time: a face is exposed where the block is opaque and its
+    // neighbour is not, so each direction is one shift or AND-NOT per 64 blocks of height
+    static void buildOpaqueFaceMasks(const Chunk &chunk, const NeighborhoodSnapshot &snapshot, OpaqueFaceMasks &masks);
 
-     static void buildMeshData(Chunk &chunk, const NeighborEdgeData &neighbors);
+    // One quad per exposed opaque face
+    static void meshOpaqueFaces(ChunkMeshBuffers &buf, const Chunk &chunk, const NeighborhoodSnapshot &snapshot,
+                                const OpaqueFaceMasks &masks);
 
-     static void uploadPendingMeshes();
+    // The per-voxel isFaceExposed path, kept as the reference for the culling benchmark
+    static void meshOpaqueFacesPerVoxel(ChunkMeshBuffers &buf, const Chunk &chunk, const NeighborhoodSnapshot &snapshot);
 
-     static ChunkMeshTriple buildChunkMeshesInternal(const Chunk &chunk, const NeighborEdgeData &neighbors);
+    // Emit the chunk's opaque faces as merged rectangles of equal texture, tint and light
+    static void greedyMeshOpaque(ChunkMeshBuffers &buf, const Chunk &chunk, const NeighborhoodSnapshot &snapshot,
+                                 const OpaqueFaceMasks &masks);
 
-     static void uploadMeshToGPU(Chunk &chunk, const ChunkMeshTriple &meshData);
+    // origin is the min corner block of the rectangle; width runs along the face's u axis, height along v
+    static void AddGreedyQuad(ChunkMeshBuffers &buf, const int origin[3], int face, int width, int height,
+                              int tile, int light, int tint);
 
-     static std::vector<std::thread> workers;
+     // Runs generation, lighting and meshing for every chunk
+     static std::unique_ptr<JobSystem> jobs;
 
     static UVRect GetAtlasUV(int tileIndex, int atlasWidth, int atlasHeight, int tileWidth, int tileHeight);
 
-     static void initChunkWorkers(int threadCount);
+     // Start the job system; threadCount <= 0 sizes it to the machine
+     static void initJobSystem(int threadCount);
+
+     // Stop the job system, dropping anything still queued
+     static void shutdownJobSystem();
+
+     // Queue generation of the most urgent request, then its lighting as a dependent job
+     static void submitChunkGeneration();
 
      static void replaceChunk(const ChunkCoord &coord, std::unique_ptr<Chunk> newChunk);
 
@@ -153,6 +244,9 @@ public:
 
     static bool isFaceExposed(const Chunk &chunk, int x, int y, int z, int face);
 
+    // True when a fully opaque section is enclosed by opaque sections and neighbour edges
+    static bool isSectionBuried(const Chunk &chunk, int section, const NeighborhoodSnapshot &snapshot);
+
      static Plane normalizePlane(const Plane &plane);
 
      static bool isBoxOnScreen(const BoundingBox &box, const Camera3D &camera);
@@ -167,10 +261,51 @@ public:
 
      static void buildChunkModel(const Chunk &chunk);
 
+     // Request generation of every missing chunk in range, nearest and most in view first
      static void checkActiveChunks(const Camera3D &camera);
 
+    // Lower is generated sooner: distance in chunks, scaled down ahead of the camera and up behind
+    static float chunkRequestPriority(const ChunkCoord &coord, const ChunkCoord &playerChunk, Vector2 forward);
+
+    // Where the queued requests were last scored from
+    static ChunkCoord lastRequestChunk;
+    static Vector2 lastRequestForward;
+
+    // Player chunk as of the last checkActiveChunks, read by generation workers. The two halves
+    // may be a frame apart, which only delays a stale check.
+    static std::atomic<int> requestCenterX;
+    static std::atomic<int> requestCenterZ;
+
+    // True once coord has left the preload square around center
+    static bool isRequestStale(const ChunkCoord &coord, const ChunkCoord &center);
+
+    // Forget an in-flight request, so the chunk can be requested again
+    static void finishChunkRequest(const ChunkCoord &coord);
+
+    // Requests dropped before generation, and chunks generated only to be thrown away
+    static std::atomic<int> skippedChunkJobs;
+    static std::atomic<int> wastedChunkJobs;
+
+    // Rebuilds thrown away because the chunk changed while they ran
+    static std::atomic<int> staleRebuilds;
+
+     // Unload chunks past unloadDistance, then the farthest ones past preLoadDistance while over
+     // the memory budget. Their GPU meshes and storage are freed a few per frame afterwards.
      static void unloadChunks(const Camera3D &camera_3d);
 
+    // Take an unloaded chunk out of streaming and queue its meshes and storage to be freed, along
+    // with any upload still in flight for it. Caller holds activeChunksMutex.
+    static void retireChunk(std::unique_ptr<Chunk> chunk);
+
+    // Frees queued by retireChunk, drained UNLOAD_FREES_PER_FRAME at a time. Main thread only.
+    static std::vector<ChunkGpuMesh> meshFreeQueue;
+    static std::vector<std::unique_ptr<Chunk>> retiredChunks;
+    static constexpr int UNLOAD_FREES_PER_FRAME = 16;
+
+    // As of the last unloadChunks, for debug output
+    static size_t residentChunkBytes;
+    static int unloadedChunkCount;
+
      static int worldToChunk(float v, int chunkSize);
 
      static void drawChunk(const std::unique_ptr<Chunk> &chunk, const Camera3D &camera);
@@ -186,6 +321,17 @@ public:
 
      static void processChunkBuildQueue(const Camera3D &camera);
 
+    // Generated chunks that have not been meshed yet. Meshing waits until all four horizontal
+    // neighbours are loaded so edge faces are only built once. Main thread only.
+    static std::unordered_set<ChunkCoord, ChunkCoordHash> chunksAwaitingNeighbors;
+
+    // True once every +-X/+-Z neighbour inside the load radius is loaded; the outer ring does
+    // not wait for the side facing out. Caller holds activeChunksMutex.
+    static bool isReadyToMesh(const ChunkCoord &coord, const ChunkCoord &playerChunk);
+
+    // Submit mesh jobs for every waiting chunk that isReadyToMesh
+    static void queueChunksWithNeighbors(const Camera3D &camera);
+
      static ChunkCoord getPlayerChunkCoord(const Camera3D &camera);
 
     static void drawCrosshair();
@@ -204,24 +350,46 @@ public:
     // In Chunk.hpp
     static void rebuildDirtyChunks();
 
-     static Model createModelFromBuffers(const ChunkMeshBuffers &buf, const ChunkCoord &coord);
+    // Queue buildChunkMesh for chunk and mark it meshBuilding until the job commits. The only way
+    // a chunk gets meshed, first time or after an edit. Caller holds activeChunksMutex.
+    static void submitChunkMesh(Chunk &chunk, JobPriority priority);
+
+    // Mesh one chunk from a snapshot, holding activeChunksMutex only to take the snapshot and to
+    // commit pendingMeshData. The result is dropped if the chunk's version moved on.
+    static void buildChunkMesh(const ChunkCoord &coord);
+
+     // Copy packed vertices into the mesh arena; an empty buffer gives an invalid mesh
+     static ChunkGpuMesh createMeshFromBuffers(const ChunkMeshBuffers &buf);
+
+     static void unloadChunkMesh(ChunkGpuMesh &mesh);
+
+     static void unloadChunkMeshes(const Chunk &chunk);
+
+     // Shared VAO pages and index buffer behind every chunk mesh
+     static ChunkMeshArena meshArena;
 
-     static void buildChunkMeshAsync(Chunk &chunk);
+     // Flush raylib's batch and bind the state every chunk draw shares; pair with endChunkDraws
+     static void beginChunkDraws();
+     static void endChunkDraws();
 
-     static void uploadMeshToGPU(Chunk &chunk);
+     // Draw with the chunk or water shader, only rebinding what changed since the last call.
+     // Must sit between beginChunkDraws and endChunkDraws; tint feeds colDiffuse
+     static void drawChunkMesh(const ChunkGpuMesh &mesh, const Shader &shader, Vector3 position, Color tint);
 
-     static bool isFaceExposed(const Chunk &chunk, int x, int y, int z, int face, bool isTranslucent, const NeighborEdgeData &neighbors);
+    // Chunk meshes built since startup, for judging streaming overhead
+    static std::atomic<int> meshBuildCount;
+
+     static bool isFaceExposed(const NeighborhoodSnapshot &snapshot, int x, int y, int z, int face, bool isTranslucent);
 
     static ChunkMeshTriple buildChunkMeshes(const Chunk &chunk);
 
-     static void AddFaceWithAlpha(ChunkMeshBuffers &buf, const Vector3 &blockPos, int face, const BlockTextureDef &def,
-                                  float lightLevel, Color tint, unsigned char alpha, const Chunk &chunk, const NeighborEdgeData &neighbors);
+     static void AddFaceWithAlpha(ChunkMeshBuffers &buf, int x, int y, int z, int face, int tile, int light,
+                                  int tint, unsigned char alpha);
 
-    static Model buildModelFromBuffers(ChunkMeshBuffers &buf);
-    static void drawChunkOpaque(const std::unique_ptr<Chunk> &chunk, const Camera3D &camera);
-    static void drawChunkTranslucent(const std::unique_ptr<Chunk> &chunk, const Camera3D &camera);
+    static void drawChunkOpaque(Chunk *chunk, const Camera3D &camera);
+    static void drawChunkTranslucent(const Chunk *chunk, const Camera3D &camera);
 
-     static void drawChunkWater(const std::unique_ptr<Chunk> &chunk, const Camera3D &camera);
+     static void drawChunkWater(const Chunk *chunk, const Camera3D &camera);
 
      static void drawAllChunks(const Camera3D &camera);
 
@@ -235,21 +403,32 @@ public:
     // In Renderer.hpp
     static Shader waterShader;
     static int waterTimeLoc;
+    static int waterOffsetLoc;
 
     // Cached frustum planes - updated once per frame
     static Plane cachedFrustumPlanes[6];
     static bool frustumPlanesValid;
 
+    // Unpacks PackedVertex and derives repeating texcoords, so greedy quads tile their texture
+    static Shader chunkShader;
+    static int chunkOffsetLoc;
+
+    // Distinct block tints, indexed by the tint field of PackedVertex
+    static constexpr int MAX_TINT_PALETTE = 64;
+    static std::vector<Color> tintPalette;
+    static uint8_t tintIndices[BLOCK_ID_COUNT][6][BIOME_COUNT];
+
+    static void initTintPalette();
+    static int getTintIndex(BlockIds id, int face, int biome) { return tintIndices[id][face][biome]; }
+
     static void initWaterShader();
+    static void initChunkShader();
     static void updateWaterShader(float time);
     static void updateFrustumPlanes(const Camera3D& camera);
     static bool isBoxInCachedFrustum(const BoundingBox& box);
 
-     static float getVertexLight(const Chunk &chunk, int bx, int by, int bz, int face, int vertex, const NeighborEdgeData &neighbors);
-
-     static void initMeshThreadPool(int threads);
-
-     static void shutdownMeshThreadPool();
+     // Light level 0-15 in front of a face; shading is applied in the chunk shader
+     static int getFaceLightLevel(const NeighborhoodSnapshot &snapshot, int bx, int by, int bz, int face);
 };
 
 // In Renderer.hpp - add these declarations
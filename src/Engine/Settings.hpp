@@ -22,9 +22,26 @@ namespace Settings {
 
     inline int renderDistance = 12;
     inline int preLoadDistance = renderDistance + 1;
+    // Chunks stay loaded out to here, past preLoadDistance, so the edge doesn't load and unload
+    // as the player moves back and forth across a boundary
     inline int unloadDistance = renderDistance + 2;
+
+    // Resident chunk data allowed before the farthest chunks past preLoadDistance are evicted early
+    inline int chunkMemoryBudgetMB = 1536;
     inline float fov = 70.0f;
+
+    // Threads in the job system shared by generation, lighting and meshing; 0 uses every core
+    // but the main thread's
+    inline int workerThreads = 0;
     inline int worldSeed = 0;
+
+    // Sample climate noise on a coarse lattice and interpolate instead of per column. Faster, but
+    // heights and biomes differ slightly from the exact sampling, so turning it on changes the
+    // terrain generated for an existing seed. Off until worlds record which mode made them.
+    inline bool coarseClimate = false;
+
+    // Merge coplanar opaque faces with the same texture, tint and light into larger quads
+    inline bool greedyMeshing = true;
     inline GameStates gameStateFlag = MENU;
     inline GameStates previousGameState = MENU;
 
@@ -375,6 +375,7 @@ void MainMenuUI::drawOptions() {
         if (Settings::preLoadDistance > 16) {
             Settings::preLoadDistance = 4;
         }
+        Settings::unloadDistance = Settings::preLoadDistance + 1;
     }
 
     // FOV
@@ -0,0 +1,105 @@
+//
+// Paletted block storage for one 16x16x16 chunk section.
+//
+
+#include "BlockStorage.hpp"
+
+#include <algorithm>
+
+static int bitsForPaletteSize(size_t size) {
+    if (size <= 1) return 0;
+    if (size <= 2) return 1;
+    if (size <= 4) return 2;
+    if (size <= 16) return 4;
+    return 8;
+}
+
+void BlockStorage::set(int index, uint8_t id) {
+    if (bitsPerEntry == 0 && palette[0] == id) return;
+
+    int paletteIndex = findOrAddPaletteEntry(id);
+    setIndex(index, paletteIndex);
+}
+
+void BlockStorage::fill(uint8_t id) {
+    palette.assign(1, id);
+    data.clear();
+    data.shrink_to_fit();
+    bitsPerEntry = 0;
+}
+
+void BlockStorage::compact() {
+    if (bitsPerEntry == 0) return;
+
+    bool used[256] = {};
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        used[get(i)] = true;
+    }
+
+    std::vector<uint8_t> newPalette;
+    for (uint8_t id : palette) {
+        if (used[id]) newPalette.push_back(id);
+    }
+
+    if (newPalette.size() == palette.size()) return;
+
+    if (newPalette.size() == 1) {
+        fill(newPalette[0]);
+        return;
+    }
+
+    uint8_t ids[SECTION_VOLUME];
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        ids[i] = get(i);
+    }
+
+    palette = std::move(newPalette);
+    bitsPerEntry = bitsForPaletteSize(palette.size());
+    data.assign(SECTION_VOLUME * bitsPerEntry / 64, 0);
+    data.shrink_to_fit();
+
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        auto it = std::find(palette.begin(), palette.end(), ids[i]);
+        setIndex(i, static_cast<uint32_t>(it - palette.begin()));
+    }
+}
+
+int BlockStorage::findOrAddPaletteEntry(uint8_t id) {
+    for (size_t i = 0; i < palette.size(); i++) {
+        if (palette[i] == id) return static_cast<int>(i);
+    }
+
+    palette.push_back(id);
+    int needed = bitsForPaletteSize(palette.size());
+    if (needed != bitsPerEntry) {
+        resize(needed);
+    }
+    return static_cast<int>(palette.size() - 1);
+}
+
+void BlockStorage::resize(int newBits) {
+    std::vector<uint64_t> newData(SECTION_VOLUME * newBits / 64, 0);
+
+    const int newPerWord = 64 / newBits;
+    for (int i = 0; i < SECTION_VOLUME; i++) {
+        uint64_t paletteIndex = 0;
+        if (bitsPerEntry > 0) {
+            const int perWord = 64 / bitsPerEntry;
+            paletteIndex =
+                (data[i / perWord] >> ((i % perWord) * bitsPerEntry)) & ((1ull << bitsPerEntry) - 1);
+        }
+        newData[i / newPerWord] |= paletteIndex << ((i % newPerWord) * newBits);
+    }
+
+    data = std::move(newData);
+    bitsPerEntry = newBits;
+}
+
+void BlockStorage::setIndex(int index, uint32_t paletteIndex) {
+    const int perWord = 64 / bitsPerEntry;
+    const int shift = (index % perWord) * bitsPerEntry;
+    const uint64_t mask = ((1ull << bitsPerEntry) - 1) << shift;
+
+    uint64_t& word = data[index / perWord];
+    word = (word & ~mask) | (static_cast<uint64_t>(paletteIndex) << shift);
+}
@@ -0,0 +1,73 @@
+//
+// Paletted block storage for one 16x16x16 chunk section.
+//
+
+#ifndef REFACTOREDCLONE_BLOCKSTORAGE_HPP
+#define REFACTOREDCLONE_BLOCKSTORAGE_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr int SECTION_SIZE = 16;
+constexpr int SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+
+// Stores 4096 block ids as indices into a small per-section palette.
+// A section holding a single id (all air, all stone) keeps no index data at all;
+// otherwise indices are bit-packed at 1, 2, 4 or 8 bits so they never straddle a word.
+//
+// Index layout is y-major: (y << 8) | (z << 4) | x, so a horizontal 16x16 slab is contiguous.
+class BlockStorage {
+public:
+    explicit BlockStorage(uint8_t fillId = 0) : palette{fillId} {}
+
+    static constexpr int indexOf(int x, int y, int z) { return (y << 8) | (z << 4) | x; }
+
+    uint8_t get(int index) const {
+        if (bitsPerEntry == 0) return palette[0];
+
+        const int perWord = 64 / bitsPerEntry;
+        const uint64_t word = data[index / perWord];
+        const int shift = (index % perWord) * bitsPerEntry;
+        return palette[(word >> shift) & ((1ull << bitsPerEntry) - 1)];
+    }
+
+    uint8_t get(int x, int y, int z) const { return get(indexOf(x, y, z)); }
+
+    void set(int index, uint8_t id);
+
+    void set(int x, int y, int z, uint8_t id) { set(indexOf(x, y, z), id); }
+
+    // Replace the whole section with a single id and drop the index data.
+    void fill(uint8_t id);
+
+    // Drop palette entries that are no longer referenced and shrink the index width.
+    // Collapses to the single-value form when only one id remains.
+    void compact();
+
+    bool isSingleValue() const { return bitsPerEntry == 0; }
+
+    // Only meaningful when isSingleValue()
+    uint8_t singleValue() const { return palette[0]; }
+
+    int getBitsPerEntry() const { return bitsPerEntry; }
+
+    const std::vector<uint8_t>& getPalette() const { return palette; }
+
+    // Heap bytes owned by this section (palette + packed indices)
+    size_t memoryUsage() const {
+        return palette.capacity() * sizeof(uint8_t) + data.capacity() * sizeof(uint64_t);
+    }
+
+private:
+    int findOrAddPaletteEntry(uint8_t id);
+    void resize(int newBits);
+    void setIndex(int index, uint32_t paletteIndex);
+
+    std::vector<uint8_t> palette;
+    std::vector<uint64_t> data;
+    int bitsPerEntry = 0;
+};
+
+#endif // REFACTOREDCLONE_BLOCKSTORAGE_HPP
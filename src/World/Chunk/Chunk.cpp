@@ -18,30 +18,113 @@
 constexpr int WATER_LEVEL = 62;
 constexpr int BEACH_LEVEL = 63;
 
-void ChunkHelper::generateChunkTerrain(const std::unique_ptr<Chunk>& chunk) {
-    int chunkOffsetX = chunk->chunkCoords.x * CHUNK_SIZE_X;
-    int chunkOffsetZ = chunk->chunkCoords.z * CHUNK_SIZE_Z;
+void ChunkHelper::sampleChunkClimate(const ChunkCoord& coord, ChunkClimate& climate) {
+    if (Settings::coarseClimate) {
+        sampleChunkClimateCoarse(coord, climate);
+    } else {
+        sampleChunkClimateExact(coord, climate);
+    }
+}
+
+void ChunkHelper::sampleChunkClimateExact(const ChunkCoord& coord, ChunkClimate& climate) {
+    constexpr int COLUMNS = CHUNK_SIZE_X * CHUNK_SIZE_Z;
+
+    int chunkOffsetX = coord.x * CHUNK_SIZE_X;
+    int chunkOffsetZ = coord.z * CHUNK_SIZE_Z;
+
+    // Grids are laid out [z][x], x fastest
+    RegionParams params[COLUMNS];
+    float terrain[COLUMNS];
+    float detail[COLUMNS];
+    Region::sampleGrid(chunkOffsetX, chunkOffsetZ, CHUNK_SIZE_X, CHUNK_SIZE_Z, 1, params);
+    Region::sampleTerrainNoise(chunkOffsetX, chunkOffsetZ, CHUNK_SIZE_X, CHUNK_SIZE_Z, terrain,
+                               detail);
 
     for (int x = 0; x < CHUNK_SIZE_X; x++) {
         for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-            int wx = chunkOffsetX + x;
-            int wz = chunkOffsetZ + z;
-            chunk->biomeMap[x][z] = ChunkHelper::getBiomeAt(wx, wz);
-
-            float surfaceY = (getSurfaceHeight(wx, wz));
-            chunk->surfaceHeight[x][z] = surfaceY;
-            for (int y = 0; y < CHUNK_SIZE_Y; y++) {
-                if (y == 0) {
-                    chunk->blockPosition[x][y][z] = ID_BEDROCK;
-                } else if (y <= surfaceY) {
-                    chunk->blockPosition[x][y][z] = ID_STONE;
-                } else {
-                    chunk->blockPosition[x][y][z] = ID_AIR;
-                }
+            int n = z * CHUNK_SIZE_X + x;
+
+            ColumnClimate& column = climate.columns[x][z];
+            column.params = params[n];
+            column.height = Region::getTerrainHeight(column.params, terrain[n], detail[n]);
+            column.biome = static_cast<BiomeType>(Region::selectBiome(column.params));
+        }
+    }
+}
+
+void ChunkHelper::sampleChunkClimateCoarse(const ChunkCoord& coord, ChunkClimate& climate) {
+    constexpr int CELL = Region::CLIMATE_CELL_SIZE;
+    constexpr int NODES_X = CHUNK_SIZE_X / CELL + 1;
+    constexpr int NODES_Z = CHUNK_SIZE_Z / CELL + 1;
+
+    int chunkOffsetX = coord.x * CHUNK_SIZE_X;
+    int chunkOffsetZ = coord.z * CHUNK_SIZE_Z;
+
+    // Lattice nodes sit on world multiples of CELL, so neighbouring chunks share their
+    // edge nodes and the interpolated climate is continuous across chunk borders.
+    // Stored [k][i], the layout sampleGrid produces.
+    RegionParams nodes[NODES_Z][NODES_X];
+    Region::sampleGrid(chunkOffsetX, chunkOffsetZ, NODES_X, NODES_Z, CELL, &nodes[0][0]);
+
+    // Terrain and detail noise vary per block, so they are still sampled at full resolution
+    float terrain[CHUNK_SIZE_Z][CHUNK_SIZE_X];
+    float detail[CHUNK_SIZE_Z][CHUNK_SIZE_X];
+    Region::sampleTerrainNoise(chunkOffsetX, chunkOffsetZ, CHUNK_SIZE_X, CHUNK_SIZE_Z,
+                               &terrain[0][0], &detail[0][0]);
+
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        int i = x / CELL;
+        float tx = (float)(x % CELL) / CELL;
+
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            int k = z / CELL;
+            float tz = (float)(z % CELL) / CELL;
+
+            ColumnClimate& column = climate.columns[x][z];
+            column.params = Region::interpolate(nodes[k][i], nodes[k][i + 1], nodes[k + 1][i],
+                                                nodes[k + 1][i + 1], tx, tz);
+            column.height = Region::getTerrainHeight(column.params, terrain[z][x], detail[z][x]);
+            column.biome = static_cast<BiomeType>(Region::selectBiome(column.params));
+        }
+    }
+}
+
+void ChunkHelper::generateChunkTerrain(const std::unique_ptr<Chunk>& chunk,
+                                       const ChunkClimate& climate) {
+    int minSurface = CHUNK_SIZE_Y;
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            chunk->biomeMap[x][z] = climate.at(x, z).biome;
+            chunk->surfaceHeight[x][z] = climate.at(x, z).height;
+            minSurface = std::min(minSurface, chunk->surfaceHeight[x][z]);
+        }
+    }
+
+    // Sections entirely below the lowest column are solid stone; fill them in one go.
+    // Section 0 is skipped because it holds the bedrock layer.
+    int solidTop = 0;
+    for (int s = 1; s < CHUNK_SECTION_COUNT; s++) {
+        if ((s + 1) * SECTION_SIZE - 1 > minSurface) break;
+        chunk->fillSection(s, ID_STONE);
+        solidTop = (s + 1) * SECTION_SIZE - 1;
+    }
+
+    for (int x = 0; x < CHUNK_SIZE_X; x++) {
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            int surfaceY = chunk->surfaceHeight[x][z];
+
+            // Chunks start as all air, so only the solid part of the column is written
+            chunk->setBlock(x, 0, z, ID_BEDROCK);
+            for (int y = 1; y <= std::min(surfaceY, SECTION_SIZE - 1); y++) {
+                chunk->setBlock(x, y, z, ID_STONE);
+            }
+            for (int y = std::max(SECTION_SIZE, solidTop + 1); y <= surfaceY && y < CHUNK_SIZE_Y;
+                 y++) {
+                chunk->setBlock(x, y, z, ID_STONE);
             }
 
             if (surfaceY < WATER_LEVEL) {
-                chunk->blockPosition[x][(int)surfaceY][z] = ID_WATER;
+                chunk->setBlock(x, surfaceY, z, ID_WATER);
             }
         }
     }
@@ -54,8 +137,7 @@ bool ChunkHelper::isSolidBlock(int x, int y, int z) {
     return density > 0.5f;
 }
 
-bool ChunkHelper::shouldPlaceTree(int wx, int wz) {
-    BiomeType biomeType = getBiomeAt(wx, wz);
+bool ChunkHelper::shouldPlaceTree(int wx, int wz, BiomeType biomeType) {
     const BiomeHelper& biome = biomes.at(biomeType);
 
     // No trees in this biome
@@ -120,12 +202,7 @@ Chunk* ChunkHelper::getChunkFromWorld(int wx, int wz) {
     int cx = floorDiv(wx, CHUNK_SIZE_X);
     int cz = floorDiv(wz, CHUNK_SIZE_Z);
 
-    ChunkCoord coord{cx, cz};
-
-    auto it = activeChunks.find(coord);
-    if (it == activeChunks.end()) return nullptr;
-
-    return it->second.get();
+    return activeChunks.find({cx, cz});
 }
 
 int ChunkHelper::getBlock(int wx, int wy, int wz) {
@@ -137,10 +214,13 @@ int ChunkHelper::getBlock(int wx, int wy, int wz) {
 
     if (wy < 0 || wy >= CHUNK_SIZE_Y) return ID_AIR;
 
-    return chunk->blockPosition[lx][wy][lz];
+    return chunk->getBlock(lx, wy, lz);
 }
 
 void ChunkHelper::setBlock(int wx, int wy, int wz, int id) {
+    // An edit can re-pack a section's palette, so it must not overlap a mesh/light job reading it
+    std::lock_guard<std::mutex> lock(activeChunksMutex);
+
     Chunk* chunk = getChunkFromWorld(wx, wz);
     if (!chunk) return;
 
@@ -149,8 +229,16 @@ void ChunkHelper::setBlock(int wx, int wy, int wz, int id) {
 
     if (wy < 0 || wy >= CHUNK_SIZE_Y) return;
 
-    chunk->blockPosition[lx][wy][lz] = id;
+    const int previous = chunk->getBlock(lx, wy, lz);
+    chunk->setBlock(lx, wy, lz, id);
+    chunk->updateBoundingBox();
     chunk->dirty = true;
+    chunk->version = ++chunkEditCounter;
+
+    if (previous != id) {
+        LightingSystem::updateLightAfterEdit(wx, wy, wz, static_cast<BlockIds>(previous),
+                                             static_cast<BlockIds>(id));
+    }
 }
 
 ChunkCoord ChunkHelper::worldToChunkCoord(int wx, int wz) {
@@ -162,15 +250,14 @@ ChunkCoord ChunkHelper::worldToChunkCoord(int wx, int wz) {
 void ChunkHelper::markChunkDirty(const ChunkCoord& coord) {
     std::lock_guard<std::mutex> lock(activeChunksMutex);
 
-    auto it = activeChunks.find(coord);
-    if (it == activeChunks.end()) return;
-
-    Chunk* chunk = it->second.get();
+    Chunk* chunk = activeChunks.find(coord);
     if (!chunk) return;
-    if (chunk->dirty) return;               // Already dirty
-    if (chunk->meshBuilding.load()) return; // Already rebuilding
+    if (chunk->dirty) return; // Already dirty
 
+    // A rebuild in flight was snapshotted before this change; the new version makes it drop
+    // its result, and dirty queues another once it's done
     chunk->dirty = true;
+    chunk->version = ++chunkEditCounter;
 }
 
 int ChunkHelper::WorldToChunk(int w) {
@@ -208,13 +295,16 @@ std::unique_ptr<Chunk> ChunkHelper::generateChunkAsync(const Vector3& chunkPosIn
     chunk->chunkCoords.x = chunkX;
     chunk->chunkCoords.z = chunkZ;
 
-    generateChunkTerrain(chunk); // terrain + caves
-    setBiomeFloor(chunk);        // grass/dirt/sand
-    populateTrees(*chunk);       // trees
+    // Climate noise is the bulk of generation cost; sample it once per column
+    ChunkClimate climate;
+    sampleChunkClimate(chunk->chunkCoords, climate);
 
-    chunk->boundingBox.min = {(float)chunkX * CHUNK_SIZE_X, 0.0f, (float)chunkZ * CHUNK_SIZE_Z};
-    chunk->boundingBox.max = {(float)chunkX * CHUNK_SIZE_X + CHUNK_SIZE_X, (float)CHUNK_SIZE_Y,
-                              (float)chunkZ * CHUNK_SIZE_Z + CHUNK_SIZE_Z};
+    generateChunkTerrain(chunk, climate); // terrain + caves
+    setBiomeFloor(chunk, climate);        // grass/dirt/sand
+    populateTrees(*chunk, climate);       // trees
+    chunk->compactSections(); // collapse all-stone / all-air sections to a single value
+
+    chunk->updateBoundingBox();
 
     chunk->chunkId = (chunkX & 0xFFFF) | ((chunkZ & 0xFFFF) << 16);
     chunk->loaded = false;
@@ -231,66 +321,61 @@ BlockIds ChunkHelper::getWorldBlock(int worldX, int worldY, int worldZ) {
 
     ChunkCoord coord = worldToChunkCoord(worldX, worldZ);
 
-    auto it = activeChunks.find(coord);
-    if (it == activeChunks.end() || !it->second) {
+    Chunk* chunk = activeChunks.find(coord);
+    if (!chunk) {
         return ID_AIR; // Assume air if chunk not loaded
     }
 
     int localX = WorldToLocal(worldX);
     int localZ = WorldToLocal(worldZ);
 
-    return static_cast<BlockIds>(it->second->blockPosition[localX][worldY][localZ]);
+    return static_cast<BlockIds>(chunk->getBlock(localX, worldY, localZ));
 }
 
-void ChunkHelper::setBiomeFloor(const std::unique_ptr<Chunk>& chunk) {
-    int baseX = chunk->chunkCoords.x * CHUNK_SIZE_X;
-    int baseZ = chunk->chunkCoords.z * CHUNK_SIZE_Z;
-
+void ChunkHelper::setBiomeFloor(const std::unique_ptr<Chunk>& chunk, const ChunkClimate& climate) {
     for (int x = 0; x < CHUNK_SIZE_X; x++) {
         for (int z = 0; z < CHUNK_SIZE_Z; z++) {
-            int wx = baseX + x;
-            int wz = baseZ + z;
             int surfaceY = static_cast<int>(chunk->surfaceHeight[x][z]);
 
-            BiomeType biomeType = getBiomeAt(wx, wz);
+            BiomeType biomeType = climate.at(x, z).biome;
             const BiomeHelper& biome = biomes.at(biomeType);
 
             // Underwater
             if (surfaceY < WATER_LEVEL) {
                 // Fill water above surface
                 for (int y = surfaceY + 1; y <= WATER_LEVEL; y++) {
-                    chunk->blockPosition[x][y][z] = ID_WATER;
+                    chunk->setBlock(x, y, z, ID_WATER);
                 }
                 // Ocean/river floor is sand
-                if (chunk->blockPosition[x][surfaceY][z] == ID_STONE) {
-                    chunk->blockPosition[x][surfaceY][z] = ID_SAND;
+                if (chunk->getBlock(x, surfaceY, z) == ID_STONE) {
+                    chunk->setBlock(x, surfaceY, z, ID_SAND);
                 }
                 continue;
             }
 
             // Surface block
-            if (chunk->blockPosition[x][surfaceY][z] == ID_STONE) {
-                chunk->blockPosition[x][surfaceY][z] = biome.surfaceBlock;
+            if (chunk->getBlock(x, surfaceY, z) == ID_STONE) {
+                chunk->setBlock(x, surfaceY, z, biome.surfaceBlock);
             }
 
             // Subsurface (3 blocks deep)
             for (int y = surfaceY - 1; y >= surfaceY - 3 && y > 0; y--) {
-                if (chunk->blockPosition[x][y][z] == ID_STONE) {
-                    chunk->blockPosition[x][y][z] = biome.subsurfaceBlock;
+                if (chunk->getBlock(x, y, z) == ID_STONE) {
+                    chunk->setBlock(x, y, z, biome.subsurfaceBlock);
                 }
             }
 
             // Snow on mountain tops
             if (biomeType == BIOME_MOUNTAINS && surfaceY > 110) {
                 // TODO: Add snow
-                chunk->blockPosition[x][surfaceY][z] = ID_GRASS;
+                chunk->setBlock(x, surfaceY, z, ID_GRASS);
             }
         }
     }
 }
 
 // ---- Tree Placement ----
-void ChunkHelper::populateTrees(Chunk& chunk) {
+void ChunkHelper::populateTrees(Chunk& chunk, const ChunkClimate& climate) {
     int baseX = chunk.chunkCoords.x * CHUNK_SIZE_X;
     int baseZ = chunk.chunkCoords.z * CHUNK_SIZE_Z;
 
@@ -304,8 +389,8 @@ void ChunkHelper::populateTrees(Chunk& chunk) {
 
             if (surfaceY <= WATER_LEVEL) continue;
             if (surfaceY >= CHUNK_SIZE_Y - 15) continue;
-            if (chunk.blockPosition[lx][surfaceY][lz] != ID_GRASS) continue;
-            if (!shouldPlaceTree(wx, wz)) continue;
+            if (chunk.getBlock(lx, surfaceY, lz) != ID_GRASS) continue;
+            if (!shouldPlaceTree(wx, wz, climate.at(lx, lz).biome)) continue;
 
             // Generate tree inline
             uint32_t h = wx * 928371u ^ wz * 123721u ^ Settings::worldSeed;
@@ -313,7 +398,7 @@ void ChunkHelper::populateTrees(Chunk& chunk) {
 
             // Trunk
             for (int y = 1; y <= height; y++) {
-                chunk.blockPosition[lx][surfaceY + y][lz] = ID_OAK_WOOD;
+                chunk.setBlock(lx, surfaceY + y, lz, ID_OAK_WOOD);
             }
 
             // Leaves
@@ -330,8 +415,8 @@ void ChunkHelper::populateTrees(Chunk& chunk) {
 
                         if (nx >= 0 && nx < CHUNK_SIZE_X && ny < CHUNK_SIZE_Y && nz >= 0 &&
                             nz < CHUNK_SIZE_Z) {
-                            if (chunk.blockPosition[nx][ny][nz] == ID_AIR) {
-                                chunk.blockPosition[nx][ny][nz] = ID_OAK_LEAF;
+                            if (chunk.getBlock(nx, ny, nz) == ID_AIR) {
+                                chunk.setBlock(nx, ny, nz, ID_OAK_LEAF);
                             }
                         }
                     }
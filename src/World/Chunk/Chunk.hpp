@@ -7,7 +7,9 @@
 #pragma once
 
 #include <FastNoiseLite.h>
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <raylib.h>
 #include <unordered_map>
 #include <vector>
@@ -21,23 +23,17 @@
 #include <unordered_set>
 
 #include "Block/Blocks.hpp"
+#include "BlockStorage.hpp"
+#include "ChunkCoord.hpp"
+#include "ChunkRegistry.hpp"
 #include "Common.hpp"
-
-struct ChunkCoord {
-    int x, z;
-
-    bool operator==(const ChunkCoord& other) const { return x == other.x && z == other.z; }
-};
-
-struct ChunkCoordHash {
-    std::size_t operator()(const ChunkCoord& c) const noexcept {
-        return std::hash<int>()(c.x) ^ (std::hash<int>()(c.z) << 1);
-    }
-};
+#include "Region/Region.hpp"
+#include "MultiThreading/LockFreeQueue.hpp"
 
 constexpr int CHUNK_SIZE_X = 16;
 constexpr int CHUNK_SIZE_Y = 256;
 constexpr int CHUNK_SIZE_Z = 16;
+constexpr int CHUNK_SECTION_COUNT = CHUNK_SIZE_Y / SECTION_SIZE;
 
 struct TerrainParams {
     // Large landmasses (continents/oceans)
@@ -229,29 +225,55 @@ inline std::unordered_map<BiomeType, BiomeHelper> biomes = {
       false}},
 };
 
+// Climate for one block column, sampled once per chunk and shared by every generation stage
+struct ColumnClimate {
+    RegionParams params;
+    float height;
+    BiomeType biome;
+};
+
+struct ChunkClimate {
+    ColumnClimate columns[CHUNK_SIZE_X][CHUNK_SIZE_Z];
+
+    const ColumnClimate& at(int x, int z) const { return columns[x][z]; }
+};
+
+// One chunk vertex in 8 bytes, unpacked by the chunk vertex shader.
+// Texcoords are not stored; the fragment shader derives them from the position and face.
+//   data[0]  y (9 bits) | face (3 bits) << 9 | light level (4 bits) << 12
+//   data[1]  x (5 bits) | z (5 bits) << 5
+//   data[2]  atlas tile index
+//   data[3]  tint palette index | alpha << 8
+struct PackedVertex {
+    uint16_t data[4];
+};
+
+inline PackedVertex packChunkVertex(int x, int y, int z, int face, int light, int tile, int tint,
+                                    int alpha) {
+    return {{(uint16_t)(y | (face << 9) | (light << 12)), (uint16_t)(x | (z << 5)),
+             (uint16_t)tile, (uint16_t)(tint | (alpha << 8))}};
+}
+
+// Vertices only: every mesh is a run of quads, and the shared index buffer in ChunkMeshArena
+// supplies the (0, 2, 1) (0, 3, 2) pattern for each group of four
 struct ChunkMeshBuffers {
-    std::vector<float> vertices;
-    std::vector<float> normals;
-    std::vector<float> texcoords;
-    std::vector<unsigned char> colors;
-    std::vector<unsigned short> indices;
-
-    void reserve(size_t expectedFaces) {
-        size_t verts = expectedFaces * 4;
-        vertices.reserve(verts * 3);
-        normals.reserve(verts * 3);
-        texcoords.reserve(verts * 2);
-        colors.reserve(verts * 4);
-        indices.reserve(expectedFaces * 6);
-    }
+    std::vector<PackedVertex> vertices;
 
-    void clear() {
-        vertices.clear();
-        normals.clear();
-        texcoords.clear();
-        colors.clear();
-        indices.clear();
-    }
+    void reserve(size_t expectedFaces) { vertices.reserve(expectedFaces * 4); }
+
+    void clear() { vertices.clear(); }
+
+    // Bytes that go to the GPU for this buffer
+    size_t byteSize() const { return vertices.size() * sizeof(PackedVertex); }
+};
+
+// A chunk mesh's slice of a ChunkMeshArena page
+struct ChunkGpuMesh {
+    int page = -1;
+    int firstVertex = 0;
+    int vertexCount = 0;
+
+    bool isValid() const { return page >= 0 && vertexCount > 0; }
 };
 
 // In buildChunkMeshes:
@@ -261,17 +283,40 @@ struct ChunkMeshTriple {
     ChunkMeshBuffers water;
 };
 
+// One 16x16x16 vertical slice of a chunk. The counts are kept in sync by Chunk::setBlock
+// so passes can skip empty sections and treat fully opaque ones as a unit.
+struct ChunkSection {
+    BlockStorage blocks;
+    uint16_t nonAirCount = 0;
+    uint16_t opaqueCount = 0;
+
+    bool isEmpty() const { return nonAirCount == 0; }
+    bool isAllOpaque() const { return opaqueCount == SECTION_VOLUME; }
+};
+
 struct Chunk {
-    int blockPosition[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
+    // Block ids, one paletted section per 16 blocks of height.
+    // Always go through getBlock/setBlock so the section counts stay correct.
+    ChunkSection sections[CHUNK_SECTION_COUNT];
+
+    Chunk() {
+        for (auto& section : sections) section.blocks.fill(ID_AIR);
+    }
+
     int surfaceHeight[CHUNK_SIZE_X][CHUNK_SIZE_Z];
+
+    // Per column, one above its highest opaque block (0 if it has none): sky light reaches every
+    // voxel from here up at full strength. Kept in sync by setBlock and fillSection.
+    uint16_t skyHeight[CHUNK_SIZE_Z][CHUNK_SIZE_X] = {};
+
     int biomeMap[CHUNK_SIZE_X][CHUNK_SIZE_Z];
     ChunkCoord chunkCoords{};
     BoundingBox boundingBox{};
 
-    // Three separate models
-    mutable Model opaqueModel = {0};
-    mutable Model translucentModel = {0}; // Leaves, glass, etc.
-    mutable Model waterModel = {0};       // Water only
+    // Three separate meshes
+    mutable ChunkGpuMesh opaqueMesh;
+    mutable ChunkGpuMesh translucentMesh; // Leaves, glass, etc.
+    mutable ChunkGpuMesh waterMesh;       // Water only
 
     mutable bool meshBuilt = false;
     mutable Material material = {0};
@@ -282,24 +327,104 @@ struct Chunk {
     float alpha = 0.0f;
     bool dirty = true;
 
+    // Stamped from ChunkHelper::chunkEditCounter whenever the chunk is edited or marked dirty,
+    // under activeChunksMutex. A rebuild snapshotted at an older version throws its result away.
+    uint64_t version = 0;
+
+    int getBlock(int x, int y, int z) const {
+        return sections[y / SECTION_SIZE].blocks.get(x, y % SECTION_SIZE, z);
+    }
+
+    void setBlock(int x, int y, int z, int id) {
+        ChunkSection& section = sections[y / SECTION_SIZE];
+        int old = section.blocks.get(x, y % SECTION_SIZE, z);
+        if (old == id) return;
+
+        section.nonAirCount += (id != ID_AIR) - (old != ID_AIR);
+        section.opaqueCount += isBlockOpaque(id) - isBlockOpaque(old);
+        section.blocks.set(x, y % SECTION_SIZE, z, static_cast<uint8_t>(id));
+
+        uint16_t& height = skyHeight[z][x];
+        if (isBlockOpaque(id)) {
+            if (y >= height) height = y + 1;
+        } else if (y + 1 == height) {
+            // The column's top opaque block went, so look down for the next one
+            while (height > 0 && !isBlockOpaque(getBlock(x, height - 1, z))) height--;
+        }
+    }
+
+    // Overwrite a whole section with one id (e.g. solid stone below the lowest surface)
+    void fillSection(int sectionIndex, int id) {
+        ChunkSection& section = sections[sectionIndex];
+        section.blocks.fill(static_cast<uint8_t>(id));
+        section.nonAirCount = (id != ID_AIR) ? SECTION_VOLUME : 0;
+        section.opaqueCount = isBlockOpaque(id) ? SECTION_VOLUME : 0;
+
+        const int sectionTop = (sectionIndex + 1) * SECTION_SIZE;
+        for (int z = 0; z < CHUNK_SIZE_Z; z++) {
+            for (int x = 0; x < CHUNK_SIZE_X; x++) {
+                uint16_t& height = skyHeight[z][x];
+                if (isBlockOpaque(id)) {
+                    height = std::max<uint16_t>(height, sectionTop);
+                } else if (height > sectionIndex * SECTION_SIZE && height <= sectionTop) {
+                    height = sectionIndex * SECTION_SIZE;
+                    while (height > 0 && !isBlockOpaque(getBlock(x, height - 1, z))) height--;
+                }
+            }
+        }
+    }
+
+    // Index of the highest section holding any non-air block, -1 if the chunk is empty
+    int getTopSection() const {
+        for (int s = CHUNK_SECTION_COUNT - 1; s >= 0; s--) {
+            if (!sections[s].isEmpty()) return s;
+        }
+        return -1;
+    }
+
+    // Shrink the bounding box to the occupied sections so frustum culling rejects
+    // chunks whose geometry is entirely below the view
+    void updateBoundingBox() {
+        float wx = (float)chunkCoords.x * CHUNK_SIZE_X;
+        float wz = (float)chunkCoords.z * CHUNK_SIZE_Z;
+        boundingBox.min = {wx, 0.0f, wz};
+        boundingBox.max = {wx + CHUNK_SIZE_X, (float)((getTopSection() + 1) * SECTION_SIZE),
+                           wz + CHUNK_SIZE_Z};
+    }
+
+    // Shrink every section's palette after bulk writes (generation)
+    void compactSections() {
+        for (auto& section : sections) section.blocks.compact();
+    }
+
+    size_t blockMemoryUsage() const {
+        size_t total = 0;
+        for (const auto& section : sections) total += section.blocks.memoryUsage();
+        return total;
+    }
+
+    // Everything this chunk keeps resident: light, section headers and block storage
+    size_t memoryUsage() const { return sizeof(Chunk) + blockMemoryUsage(); }
+
     // Packed light array: high 4 bits = sky light, low 4 bits = block light
     // This saves 65KB per chunk (130KB -> 65KB)
-    uint8_t packedLight[CHUNK_SIZE_X][CHUNK_SIZE_Y][CHUNK_SIZE_Z];
+    // Indexed [y][z][x] like the block sections, so one section's light is a contiguous 4 KB run
+    uint8_t packedLight[CHUNK_SIZE_Y][CHUNK_SIZE_Z][CHUNK_SIZE_X];
 
     void setSkyLight(int x, int y, int z, uint8_t value) {
-        packedLight[x][y][z] = (packedLight[x][y][z] & 0x0F) | ((value & 0x0F) << 4);
+        packedLight[y][z][x] = (packedLight[y][z][x] & 0x0F) | ((value & 0x0F) << 4);
     }
 
     void setBlockLight(int x, int y, int z, uint8_t value) {
-        packedLight[x][y][z] = (packedLight[x][y][z] & 0xF0) | (value & 0x0F);
+        packedLight[y][z][x] = (packedLight[y][z][x] & 0xF0) | (value & 0x0F);
     }
 
     uint8_t getSkyLight(int x, int y, int z) const {
-        return (packedLight[x][y][z] >> 4) & 0x0F;
+        return (packedLight[y][z][x] >> 4) & 0x0F;
     }
 
     uint8_t getBlockLight(int x, int y, int z) const {
-        return packedLight[x][y][z] & 0x0F;
+        return packedLight[y][z][x] & 0x0F;
     }
 
     int getLightLevel(int x, int y, int z) const {
@@ -362,6 +487,66 @@ struct ThreadSafeQueue {
     void notifyAll() { cv.notify_all(); }
 };
 
+// Generation requests, popped lowest priority value first. Priorities are fixed when pushed;
+// reprioritize re-scores everything queued, e.g. when the player moves to another chunk.
+struct ChunkRequestQueue {
+    struct Entry {
+        float priority;
+        ChunkCoord coord;
+
+        // std::*_heap builds a max-heap, so order by "is served later than"
+        bool operator<(const Entry& other) const { return priority > other.priority; }
+    };
+
+    std::vector<Entry> heap;
+    std::mutex mtx;
+
+    void push(ChunkCoord coord, float priority) {
+        std::lock_guard<std::mutex> lock(mtx);
+        heap.push_back({priority, coord});
+        std::push_heap(heap.begin(), heap.end());
+    }
+
+    bool try_pop(ChunkCoord& out) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (heap.empty()) return false;
+
+        std::pop_heap(heap.begin(), heap.end());
+        out = heap.back().coord;
+        heap.pop_back();
+        return true;
+    }
+
+    template <typename Score>
+    void reprioritize(Score score) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (Entry& entry : heap) entry.priority = score(entry.coord);
+        std::make_heap(heap.begin(), heap.end());
+    }
+
+    // Drop every queued request matching pred, returning the dropped coordinates
+    template <typename Pred>
+    std::vector<ChunkCoord> removeIf(Pred pred) {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::vector<ChunkCoord> removed;
+        auto kept = std::remove_if(heap.begin(), heap.end(), [&](const Entry& entry) {
+            if (!pred(entry.coord)) return false;
+            removed.push_back(entry.coord);
+            return true;
+        });
+        if (!removed.empty()) {
+            heap.erase(kept, heap.end());
+            std::make_heap(heap.begin(), heap.end());
+        }
+        return removed;
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return heap.empty();
+    }
+};
+
 namespace ChunkHelper {
     inline FastNoiseLite ridgeNoise; // long mountain chains
     inline FastNoiseLite riverNoise; // river paths
@@ -414,21 +599,26 @@ namespace ChunkHelper {
 
     // Linear interpolation
 
-    inline ThreadSafeQueue<std::unique_ptr<Chunk>> chunkBuildQueue;
+    // Generated and lit chunks on their way from the job system to the main thread
+    inline MpscQueue<std::unique_ptr<Chunk>> chunkBuildQueue{4096};
 
     static ThreadSafeQueue<std::unique_ptr<Chunk>>
         chunkGenQueue; // queue of std::unique_ptr<Chunk> for CPU generation
 
-    inline ThreadSafeQueue<ChunkCoord> chunkRequestQueue;
-    inline std::mutex chunkRequestQueueMtx;
+    inline ChunkRequestQueue chunkRequestQueue;
 
     inline std::unordered_set<ChunkCoord, ChunkCoordHash> chunkRequestSet;
     inline std::mutex chunkRequestSetMutex;
 
-    // GPU-ready chunks only
-    inline std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoordHash> activeChunks;
+    // GPU-ready chunks only. find() is lock-free from any thread; inserts and removals happen
+    // on the main thread under activeChunksMutex, which also guards the chunks' contents.
+    inline CoordRegistry<Chunk> activeChunks;
     inline std::mutex activeChunksMutex;
 
+    // Source of Chunk::version stamps; guarded by activeChunksMutex. Global rather than per chunk
+    // so a chunk reloaded at the same coordinate never repeats an older chunk's stamp.
+    inline uint64_t chunkEditCounter = 0;
+
     inline const unsigned int WORKER_COUNT = std::thread::hardware_concurrency();
     inline std::thread chunkWorker;
     inline std::atomic<bool> workerRunning = false;
@@ -452,7 +642,7 @@ namespace ChunkHelper {
 
     bool isSolidBlock(int x, int y, int z);
 
-    bool shouldPlaceTree(int worldX, int worldZ);
+    bool shouldPlaceTree(int worldX, int worldZ, BiomeType biomeType);
 
     void generateTree(int x, int y, int z);
 
@@ -460,7 +650,7 @@ namespace ChunkHelper {
 
     bool isCave(int worldX, int y, int worldZ);
 
-    void populateTrees(Chunk& chunk);
+    void populateTrees(Chunk& chunk, const ChunkClimate& climate);
 
     void placeWater(const std::unique_ptr<Chunk>& chunk, int chunkOffsetX, int chunkOffsetZ);
 
@@ -470,13 +660,24 @@ namespace ChunkHelper {
 
     void setBlock(int wx, int wy, int wz, int id);
 
-    void generateChunkTerrain(const std::unique_ptr<Chunk>& chunk);
+    // Sample region params, surface height and biome for all 16x16 columns of a chunk.
+    // Uses the coarse lattice when Settings::coarseClimate is on.
+    void sampleChunkClimate(const ChunkCoord& coord, ChunkClimate& climate);
+
+    // Climate noise evaluated at every column
+    void sampleChunkClimateExact(const ChunkCoord& coord, ChunkClimate& climate);
+
+    // Climate noise evaluated on a 5x5 lattice (including the neighbouring chunk's edge nodes)
+    // and interpolated; only the terrain/detail noise is still evaluated per column
+    void sampleChunkClimateCoarse(const ChunkCoord& coord, ChunkClimate& climate);
+
+    void generateChunkTerrain(const std::unique_ptr<Chunk>& chunk, const ChunkClimate& climate);
 
     ChunkCoord worldToChunkCoord(int wx, int wz);
 
     void markChunkDirty(const ChunkCoord& coord);
 
-    void setBiomeFloor(const std::unique_ptr<Chunk>& chunk);
+    void setBiomeFloor(const std::unique_ptr<Chunk>& chunk, const ChunkClimate& climate);
 
     int WorldToChunk(int w);
 
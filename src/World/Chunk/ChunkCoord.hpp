@@ -0,0 +1,40 @@
+//
+// Chunk grid coordinates and their hash.
+//
+
+#ifndef REFACTOREDCLONE_CHUNKCOORD_HPP
+#define REFACTOREDCLONE_CHUNKCOORD_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct ChunkCoord {
+    int x, z;
+
+    bool operator==(const ChunkCoord& other) const { return x == other.x && z == other.z; }
+};
+
+// Both coordinates in one word, x in the high half
+inline uint64_t chunkCoordKey(const ChunkCoord& c) {
+    return (uint64_t)(uint32_t)c.x << 32 | (uint32_t)c.z;
+}
+
+// Murmur3's 64-bit finalizer. Chunk coordinates are small, clustered and often symmetric, so
+// every input bit has to reach the low bits a power-of-two table indexes with.
+inline uint64_t mixChunkKey(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+struct ChunkCoordHash {
+    std::size_t operator()(const ChunkCoord& c) const noexcept {
+        return (std::size_t)mixChunkKey(chunkCoordKey(c));
+    }
+};
+
+#endif // REFACTOREDCLONE_CHUNKCOORD_HPP
@@ -0,0 +1,245 @@
+//
+// Open-addressed map from chunk coordinate to an owned object, with lock-free lookups.
+//
+
+#ifndef REFACTOREDCLONE_CHUNKREGISTRY_HPP
+#define REFACTOREDCLONE_CHUNKREGISTRY_HPP
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ChunkCoord.hpp"
+
+// Linear probing over a power-of-two table of (key, pointer) slots, kept at most half full.
+// Removal shifts the rest of the probe run back instead of leaving tombstones, so streaming
+// chunks in and out never degrades the table or forces a rebuild.
+//
+// find() never takes a lock. Writers bump a sequence number around every change (seqlock), and
+// a reader that overlapped one simply probes again; writes are a handful of slot stores, so a
+// retry is rare and short. Growing publishes a new table; outgrown tables stay allocated until
+// clear() since a reader may still be probing one, which costs at most the size of the
+// current table.
+//
+// Writers (insert, remove, clear) must be serialized by the caller. Iteration reads slots
+// without validation, so iterate on the writing thread or while holding the writers' lock.
+// Values are heap objects that never move, so a T* stays valid until the caller frees what
+// remove() hands back.
+template <typename T>
+class CoordRegistry {
+public:
+    CoordRegistry() {
+        tables.push_back(std::make_unique<Table>(MIN_CAPACITY));
+        current = tables.back().get();
+    }
+    ~CoordRegistry() { clear(); }
+
+    CoordRegistry(const CoordRegistry&) = delete;
+    CoordRegistry& operator=(const CoordRegistry&) = delete;
+
+    T* find(const ChunkCoord& coord) const {
+        const uint64_t key = chunkCoordKey(coord);
+        const uint64_t hash = mixChunkKey(key);
+
+        for (;;) {
+            const uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            T* found = probe(*current.load(std::memory_order_acquire), key, hash);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) return found;
+        }
+    }
+
+    bool contains(const ChunkCoord& coord) const { return find(coord) != nullptr; }
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+
+    // Store value at coord, handing back whatever was there before
+    std::unique_ptr<T> insert(const ChunkCoord& coord, std::unique_ptr<T> value) {
+        if (!value) return remove(coord);
+        if ((size() + 1) * 2 > capacity()) grow();
+
+        const uint64_t key = chunkCoordKey(coord);
+        Table& table = *current.load(std::memory_order_relaxed);
+
+        size_t i = mixChunkKey(key) & table.mask;
+        while (table.slots[i].value.load(std::memory_order_relaxed)) {
+            if (table.slots[i].key.load(std::memory_order_relaxed) == key) {
+                beginWrite();
+                T* previous =
+                    table.slots[i].value.exchange(value.release(), std::memory_order_relaxed);
+                endWrite();
+                return std::unique_ptr<T>(previous);
+            }
+            i = (i + 1) & table.mask;
+        }
+
+        beginWrite();
+        table.slots[i].key.store(key, std::memory_order_relaxed);
+        table.slots[i].value.store(value.release(), std::memory_order_relaxed);
+        endWrite();
+
+        count.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // Take coord's value out of the registry, or null if there is none
+    std::unique_ptr<T> remove(const ChunkCoord& coord) {
+        const uint64_t key = chunkCoordKey(coord);
+        Table& table = *current.load(std::memory_order_relaxed);
+
+        size_t hole = mixChunkKey(key) & table.mask;
+        for (;;) {
+            if (!table.slots[hole].value.load(std::memory_order_relaxed)) return nullptr;
+            if (table.slots[hole].key.load(std::memory_order_relaxed) == key) break;
+            hole = (hole + 1) & table.mask;
+        }
+
+        T* removed = table.slots[hole].value.load(std::memory_order_relaxed);
+
+        beginWrite();
+        // Pull later members of the run back into the hole, unless that would put one before
+        // its home slot where a probe for it would never look
+        for (size_t j = (hole + 1) & table.mask;; j = (j + 1) & table.mask) {
+            T* value = table.slots[j].value.load(std::memory_order_relaxed);
+            if (!value) break;
+
+            const uint64_t movedKey = table.slots[j].key.load(std::memory_order_relaxed);
+            const size_t home = mixChunkKey(movedKey) & table.mask;
+            if (((j - home) & table.mask) < ((j - hole) & table.mask)) continue;
+
+            table.slots[hole].key.store(movedKey, std::memory_order_relaxed);
+            table.slots[hole].value.store(value, std::memory_order_relaxed);
+            hole = j;
+        }
+        table.slots[hole].value.store(nullptr, std::memory_order_relaxed);
+        endWrite();
+
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return std::unique_ptr<T>(removed);
+    }
+
+    // Delete every value and drop outgrown tables. No other thread may be reading.
+    void clear() {
+        Table& table = *current.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= table.mask; i++) {
+            delete table.slots[i].value.exchange(nullptr, std::memory_order_relaxed);
+        }
+        count = 0;
+
+        std::unique_ptr<Table> keep = std::move(tables.back());
+        tables.clear();
+        tables.push_back(std::move(keep));
+    }
+
+private:
+    static constexpr size_t MIN_CAPACITY = 64;
+
+    struct Slot {
+        std::atomic<uint64_t> key{0};
+        std::atomic<T*> value{nullptr}; // Null marks an empty slot
+    };
+
+    struct Table {
+        explicit Table(size_t capacity)
+            : mask(capacity - 1), slots(std::make_unique<Slot[]>(capacity)) {}
+
+        size_t mask;
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    static T* probe(const Table& table, uint64_t key, uint64_t hash) {
+        size_t i = hash & table.mask;
+        // Bounded so a view torn by a concurrent write can't spin; the sequence check rejects it
+        for (size_t n = 0; n <= table.mask; n++) {
+            T* value = table.slots[i].value.load(std::memory_order_relaxed);
+            if (!value) return nullptr;
+            if (table.slots[i].key.load(std::memory_order_relaxed) == key) return value;
+            i = (i + 1) & table.mask;
+        }
+        return nullptr;
+    }
+
+    size_t capacity() const { return current.load(std::memory_order_relaxed)->mask + 1; }
+
+    void beginWrite() {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endWrite() {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void grow() {
+        const Table& old = *current.load(std::memory_order_relaxed);
+        auto bigger = std::make_unique<Table>((old.mask + 1) * 2);
+
+        // Nobody can see the new table yet, so it fills without the sequence
+        for (size_t i = 0; i <= old.mask; i++) {
+            T* value = old.slots[i].value.load(std::memory_order_relaxed);
+            if (!value) continue;
+
+            const uint64_t key = old.slots[i].key.load(std::memory_order_relaxed);
+            size_t j = mixChunkKey(key) & bigger->mask;
+            while (bigger->slots[j].value.load(std::memory_order_relaxed)) {
+                j = (j + 1) & bigger->mask;
+            }
+            bigger->slots[j].key.store(key, std::memory_order_relaxed);
+            bigger->slots[j].value.store(value, std::memory_order_relaxed);
+        }
+
+        beginWrite();
+        current.store(bigger.get(), std::memory_order_release);
+        endWrite();
+        tables.push_back(std::move(bigger));
+    }
+
+    std::atomic<Table*> current{nullptr};
+    std::vector<std::unique_ptr<Table>> tables; // Every table still allocated, current last
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<size_t> count{0};
+
+public:
+    // Visits every value; see the class comment for when this is safe
+    class Iterator {
+    public:
+        Iterator(const CoordRegistry* registry, size_t index)
+            : table(registry->current.load()), index(index) {
+            skipEmpty();
+        }
+
+        T* operator*() const { return table->slots[index].value.load(std::memory_order_relaxed); }
+        Iterator& operator++() {
+            index++;
+            skipEmpty();
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+    private:
+        void skipEmpty() {
+            while (index <= table->mask &&
+                   !table->slots[index].value.load(std::memory_order_relaxed)) {
+                index++;
+            }
+        }
+
+        const Table* table;
+        size_t index;
+    };
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, capacity()); }
+};
+
+#endif // REFACTOREDCLONE_CHUNKREGISTRY_HPP
@@ -6,6 +6,7 @@
 #include "../Chunk/Chunk.hpp"
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 RegionParams Region::sampleAt(int worldX, int worldZ) {
     RegionParams params;
@@ -18,6 +19,57 @@ RegionParams Region::sampleAt(int worldX, int worldZ) {
     return params;
 }
 
+void Region::sampleGrid(int worldX, int worldZ, int countX, int countZ, int step,
+                        RegionParams* out) {
+    const int count = countX * countZ;
+    std::vector<float> raw(count);
+
+    auto sample = [&](const FastNoiseLite& noise, float RegionParams::*field, float scale) {
+        noise.GetNoiseGrid2D(raw.data(), (float)worldX, (float)worldZ, countX, countZ,
+                             (float)step);
+        for (int n = 0; n < count; n++) {
+            out[n].*field = std::clamp(raw[n] * scale, -1.0f, 1.0f);
+        }
+    };
+
+    // Scales mirror the individual getters above
+    sample(ChunkHelper::continentalnessNoise, &RegionParams::continentalness, 1.2f);
+    sample(ChunkHelper::temperatureNoise, &RegionParams::temperature, 1.0f);
+    sample(ChunkHelper::humidityNoise, &RegionParams::humidity, 1.0f);
+    sample(ChunkHelper::erosionNoise, &RegionParams::erosion, 1.0f);
+    sample(ChunkHelper::peakNoise, &RegionParams::weirdness, 1.0f);
+
+    for (int n = 0; n < count; n++) {
+        out[n].depth = 0.0f;
+    }
+}
+
+void Region::sampleTerrainNoise(int worldX, int worldZ, int countX, int countZ, float* terrain,
+                                float* detail) {
+    ChunkHelper::terrainNoise.GetNoiseGrid2D(terrain, (float)worldX, (float)worldZ, countX,
+                                             countZ);
+    ChunkHelper::detailNoise.GetNoiseGrid2D(detail, (float)worldX, (float)worldZ, countX, countZ);
+}
+
+RegionParams Region::interpolate(const RegionParams& p00, const RegionParams& p10,
+                                 const RegionParams& p01, const RegionParams& p11, float tx,
+                                 float tz) {
+    auto blend = [&](float RegionParams::*field) {
+        float top = p00.*field + (p10.*field - p00.*field) * tx;
+        float bottom = p01.*field + (p11.*field - p01.*field) * tx;
+        return top + (bottom - top) * tz;
+    };
+
+    RegionParams params;
+    params.continentalness = blend(&RegionParams::continentalness);
+    params.temperature = blend(&RegionParams::temperature);
+    params.humidity = blend(&RegionParams::humidity);
+    params.erosion = blend(&RegionParams::erosion);
+    params.weirdness = blend(&RegionParams::weirdness);
+    params.depth = 0.0f;
+    return params;
+}
+
 float Region::getContinentalness(int worldX, int worldZ) {
     float raw = ChunkHelper::continentalnessNoise.GetNoise((float)worldX, (float)worldZ);
     // Apply slight amplification to make continents more distinct
@@ -66,13 +118,17 @@ float Region::getPeakValleyFactor(const RegionParams& params) {
 }
 
 float Region::getTerrainHeight(const RegionParams& params, int worldX, int worldZ) {
-    const float SEA_LEVEL = 62.0f;
-    const float BASE_HEIGHT = 64.0f;
-
     // Sample detail noise for local variation
     float terrain = ChunkHelper::terrainNoise.GetNoise((float)worldX, (float)worldZ);
     float detail = ChunkHelper::detailNoise.GetNoise((float)worldX, (float)worldZ);
 
+    return getTerrainHeight(params, terrain, detail);
+}
+
+float Region::getTerrainHeight(const RegionParams& params, float terrain, float detail) {
+    const float SEA_LEVEL = 62.0f;
+    const float BASE_HEIGHT = 64.0f;
+
     float height;
 
     // Deep ocean
@@ -42,6 +42,25 @@ public:
     // Sample all regional parameters at a world position
     static RegionParams sampleAt(int worldX, int worldZ);
 
+    // Sample a countX * countZ grid of regional parameters starting at a world position,
+    // `step` blocks apart. Output is row-major with x fastest: out[k * countX + i].
+    // Uses the batch noise path, so it is much cheaper than calling sampleAt per point.
+    static void sampleGrid(int worldX, int worldZ, int countX, int countZ, int step,
+                           RegionParams* out);
+
+    // Batch-sample the terrain and detail noise used by getTerrainHeight (same layout as sampleGrid)
+    static void sampleTerrainNoise(int worldX, int worldZ, int countX, int countZ, float* terrain,
+                                   float* detail);
+
+    // Spacing of the coarse climate lattice. The climate noises are all very low frequency,
+    // so sampling them every few blocks and interpolating is visually indistinguishable.
+    static constexpr int CLIMATE_CELL_SIZE = 4;
+
+    // Bilinear blend of four lattice samples (p00 at the min corner, p11 at the max corner)
+    static RegionParams interpolate(const RegionParams& p00, const RegionParams& p10,
+                                    const RegionParams& p01, const RegionParams& p11, float tx,
+                                    float tz);
+
     // Get continentalness (-1 = deep ocean, 0 = coast, 1 = inland)
     static float getContinentalness(int worldX, int worldZ);
 
@@ -60,6 +79,9 @@ public:
     // Calculate base terrain height from regional parameters
     static float getTerrainHeight(const RegionParams& params, int worldX, int worldZ);
 
+    // Same, with the terrain/detail noise already sampled (see sampleTerrainNoise)
+    static float getTerrainHeight(const RegionParams& params, float terrain, float detail);
+
     // Select biome based on regional parameters (Minecraft-style)
     static int selectBiome(const RegionParams& params);
 